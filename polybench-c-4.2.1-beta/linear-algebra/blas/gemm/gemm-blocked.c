@@ -0,0 +1,281 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* gemm-blocked.c: this file is part of PolyBench/C */
+
+/* Cache-blocked, register-tiled variant of gemm.c. Panels of A and B are
+   packed into contiguous buffers sized for the caches (GEMM_MC x GEMM_KC
+   for A, GEMM_KC x GEMM_NC for B), and a GEMM_MR x GEMM_NR micro-kernel
+   accumulates a tile of C in registers. On x86-64 the micro-kernel is
+   cloned for AVX-512, AVX2 and the baseline ISA, the best one being
+   selected at load time. Build with optimizations (e.g. -O3) for the
+   micro-kernel to be vectorized. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "gemm.h"
+
+/* Register tile: GEMM_NR is one 512-bit vector of DATA_TYPE. */
+#ifndef GEMM_MR
+# define GEMM_MR 6
+#endif
+#ifndef GEMM_NR
+# define GEMM_NR (64 / (int) sizeof(DATA_TYPE))
+#endif
+/* Cache blocks: A panels in L2, B micro-panels in L1, B panels in L3. */
+#ifndef GEMM_MC
+# define GEMM_MC 96
+#endif
+#ifndef GEMM_KC
+# define GEMM_KC 256
+#endif
+#ifndef GEMM_NC
+# define GEMM_NC 2048
+#endif
+
+
+/* Array initialization. */
+static
+void init_array(int ni, int nj, int nk,
+		DATA_TYPE *alpha,
+		DATA_TYPE *beta,
+		DATA_TYPE POLYBENCH_2D(C,NI,NJ,ni,nj),
+		DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj))
+{
+  int i, j;
+
+  *alpha = 1.5;
+  *beta = 1.2;
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nj; j++)
+      C[i][j] = (DATA_TYPE) ((i*j+1) % ni) / ni;
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nk; j++)
+      A[i][j] = (DATA_TYPE) (i*(j+1) % nk) / nk;
+  for (i = 0; i < nk; i++)
+    for (j = 0; j < nj; j++)
+      B[i][j] = (DATA_TYPE) (i*(j+2) % nj) / nj;
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int ni, int nj,
+		 DATA_TYPE POLYBENCH_2D(C,NI,NJ,ni,nj))
+{
+  int i, j;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("C");
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nj; j++) {
+	if ((i * ni + j) % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+	fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, C[i][j]);
+    }
+  POLYBENCH_DUMP_END("C");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* Packs alpha * A[i0:i0+mc][k0:k0+kc] as GEMM_MR-row micro-panels, each
+   stored column by column. Rows past mc are zero. */
+static
+void pack_a(int mc, int kc, int i0, int k0, int lda,
+	    DATA_TYPE alpha, const DATA_TYPE *A, DATA_TYPE *Ap)
+{
+  int i, p, ir;
+
+  for (ir = 0; ir < mc; ir += GEMM_MR)
+    for (p = 0; p < kc; p++)
+      for (i = 0; i < GEMM_MR; i++)
+	*Ap++ = (ir + i < mc) ? alpha * A[(i0 + ir + i) * lda + k0 + p] : 0;
+}
+
+/* Packs B[k0:k0+kc][j0:j0+nc] as GEMM_NR-column micro-panels, each stored
+   row by row. Columns past nc are zero. */
+static
+void pack_b(int kc, int nc, int k0, int j0, int ldb,
+	    const DATA_TYPE *B, DATA_TYPE *Bp)
+{
+  int j, p, jr;
+
+  for (jr = 0; jr < nc; jr += GEMM_NR)
+    for (p = 0; p < kc; p++)
+      for (j = 0; j < GEMM_NR; j++)
+	*Bp++ = (jr + j < nc) ? B[(k0 + p) * ldb + j0 + jr + j] : 0;
+}
+
+/* C[0:mr][0:nr] += Ap * Bp over kc, accumulated in registers. With GNU C
+   vector types every row of the tile is a single GEMM_NR-wide vector. */
+#if defined(__GNUC__)
+typedef DATA_TYPE gemm_row_t __attribute__((vector_size(GEMM_NR * sizeof(DATA_TYPE))));
+
+static POLYBENCH_ISA_CLONES
+void micro_kernel(int kc, int mr, int nr, int ldc,
+		  const DATA_TYPE *POLYBENCH_RESTRICT Ap,
+		  const DATA_TYPE *POLYBENCH_RESTRICT Bp,
+		  DATA_TYPE *C)
+{
+  gemm_row_t acc[GEMM_MR], b;
+  DATA_TYPE out[GEMM_MR][GEMM_NR];
+  int i, j, p;
+
+  for (i = 0; i < GEMM_MR; i++)
+    acc[i] = (gemm_row_t) {0};
+  for (p = 0; p < kc; p++) {
+    memcpy(&b, Bp + p * GEMM_NR, sizeof(b));
+    for (i = 0; i < GEMM_MR; i++)
+      acc[i] += b * Ap[p * GEMM_MR + i];
+  }
+  memcpy(out, acc, sizeof(out));
+  for (i = 0; i < mr; i++)
+    for (j = 0; j < nr; j++)
+      C[i * ldc + j] += out[i][j];
+}
+#else
+static
+void micro_kernel(int kc, int mr, int nr, int ldc,
+		  const DATA_TYPE *POLYBENCH_RESTRICT Ap,
+		  const DATA_TYPE *POLYBENCH_RESTRICT Bp,
+		  DATA_TYPE *C)
+{
+  DATA_TYPE acc[GEMM_MR][GEMM_NR];
+  int i, j, p;
+
+  for (i = 0; i < GEMM_MR; i++)
+    for (j = 0; j < GEMM_NR; j++)
+      acc[i][j] = 0;
+  for (p = 0; p < kc; p++)
+    for (i = 0; i < GEMM_MR; i++)
+      for (j = 0; j < GEMM_NR; j++)
+	acc[i][j] += Ap[p * GEMM_MR + i] * Bp[p * GEMM_NR + j];
+  for (i = 0; i < mr; i++)
+    for (j = 0; j < nr; j++)
+      C[i * ldc + j] += acc[i][j];
+}
+#endif
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_gemm(int ni, int nj, int nk,
+		 DATA_TYPE alpha,
+		 DATA_TYPE beta,
+		 DATA_TYPE POLYBENCH_2D(C,NI,NJ,ni,nj),
+		 DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		 DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj),
+		 DATA_TYPE *Ap,
+		 DATA_TYPE *Bp)
+{
+  /* Row strides, padding included. */
+  const int ldc = (int) (&C[1][0] - &C[0][0]);
+  const int lda = (int) (&A[1][0] - &A[0][0]);
+  const int ldb = (int) (&B[1][0] - &B[0][0]);
+  int i, j, jc, kc, ic, jr, ir;
+
+//BLAS PARAMS
+//TRANSA = 'N'
+//TRANSB = 'N'
+// => Form C := alpha*A*B + beta*C,
+//A is NIxNK
+//B is NKxNJ
+//C is NIxNJ
+#pragma scop
+  for (i = 0; i < _PB_NI; i++)
+    for (j = 0; j < _PB_NJ; j++)
+      C[i][j] *= beta;
+  for (jc = 0; jc < _PB_NJ; jc += GEMM_NC) {
+    int nc = _PB_NJ - jc < GEMM_NC ? _PB_NJ - jc : GEMM_NC;
+    for (kc = 0; kc < _PB_NK; kc += GEMM_KC) {
+      int kb = _PB_NK - kc < GEMM_KC ? _PB_NK - kc : GEMM_KC;
+      pack_b(kb, nc, kc, jc, ldb, &B[0][0], Bp);
+      for (ic = 0; ic < _PB_NI; ic += GEMM_MC) {
+	int mc = _PB_NI - ic < GEMM_MC ? _PB_NI - ic : GEMM_MC;
+	pack_a(mc, kb, ic, kc, lda, alpha, &A[0][0], Ap);
+	for (jr = 0; jr < nc; jr += GEMM_NR)
+	  for (ir = 0; ir < mc; ir += GEMM_MR)
+	    micro_kernel(kb,
+			 mc - ir < GEMM_MR ? mc - ir : GEMM_MR,
+			 nc - jr < GEMM_NR ? nc - jr : GEMM_NR,
+			 ldc,
+			 Ap + ir * kb,
+			 Bp + jr * kb,
+			 &C[ic + ir][jc + jr]);
+      }
+    }
+  }
+#pragma endscop
+
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int ni = NI;
+  int nj = NJ;
+  int nk = NK;
+
+  /* Variable declaration/allocation. */
+  DATA_TYPE alpha;
+  DATA_TYPE beta;
+  POLYBENCH_2D_ARRAY_DECL(C,DATA_TYPE,NI,NJ,ni,nj);
+  POLYBENCH_2D_ARRAY_DECL(A,DATA_TYPE,NI,NK,ni,nk);
+  POLYBENCH_2D_ARRAY_DECL(B,DATA_TYPE,NK,NJ,nk,nj);
+  /* Packing buffers, rounded up to whole micro-panels. */
+  POLYBENCH_1D_ARRAY_DECL(Ap,DATA_TYPE,(GEMM_MC + GEMM_MR) * GEMM_KC,
+			  (GEMM_MC + GEMM_MR) * GEMM_KC);
+  POLYBENCH_1D_ARRAY_DECL(Bp,DATA_TYPE,(GEMM_NC + GEMM_NR) * GEMM_KC,
+			  (GEMM_NC + GEMM_NR) * GEMM_KC);
+
+  /* Initialize array(s). */
+  init_array (ni, nj, nk, &alpha, &beta,
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_gemm (ni, nj, nk,
+	       alpha, beta,
+	       POLYBENCH_ARRAY(C),
+	       POLYBENCH_ARRAY(A),
+	       POLYBENCH_ARRAY(B),
+	       POLYBENCH_ARRAY(Ap),
+	       POLYBENCH_ARRAY(Bp));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(ni, nj,  POLYBENCH_ARRAY(C)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(C);
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(B);
+  POLYBENCH_FREE_ARRAY(Ap);
+  POLYBENCH_FREE_ARRAY(Bp);
+
+  return 0;
+}
@@ -0,0 +1,204 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* gemm-parallel.c: this file is part of PolyBench/C */
+
+/* Multithreaded variant of gemm.c: C is split into TILE_I x TILE_J tiles
+   scheduled by the work-stealing pool of polybench_steal.h, and every
+   tile is computed in TILE_K slices of the k loop. Build with -fopenmp,
+   and -DPOLYBENCH_THREADS=N to set the number of threads. Every element
+   of C is accumulated in the order of gemm.c. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "gemm.h"
+
+#include <polybench_steal.h>
+
+#ifndef TILE_I
+# define TILE_I 64
+#endif
+#ifndef TILE_J
+# define TILE_J 256
+#endif
+#ifndef TILE_K
+# define TILE_K 128
+#endif
+
+
+/* Array initialization. */
+static
+void init_array(int ni, int nj, int nk,
+		DATA_TYPE *alpha,
+		DATA_TYPE *beta,
+		DATA_TYPE POLYBENCH_2D(C,NI,NJ,ni,nj),
+		DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj))
+{
+  int i, j;
+
+  *alpha = 1.5;
+  *beta = 1.2;
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nj; j++)
+      C[i][j] = (DATA_TYPE) ((i*j+1) % ni) / ni;
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nk; j++)
+      A[i][j] = (DATA_TYPE) (i*(j+1) % nk) / nk;
+  for (i = 0; i < nk; i++)
+    for (j = 0; j < nj; j++)
+      B[i][j] = (DATA_TYPE) (i*(j+2) % nj) / nj;
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int ni, int nj,
+		 DATA_TYPE POLYBENCH_2D(C,NI,NJ,ni,nj))
+{
+  int i, j;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("C");
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nj; j++) {
+	if ((i * ni + j) % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+	fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, C[i][j]);
+    }
+  POLYBENCH_DUMP_END("C");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* C[i0:i1][j0:j1] = beta * C + alpha * A[i0:i1][:] * B[:][j0:j1] */
+static
+void gemm_tile(int i0, int i1, int j0, int j1, int nk,
+	       DATA_TYPE alpha, DATA_TYPE beta,
+	       DATA_TYPE *C, int ldc,
+	       const DATA_TYPE *A, int lda,
+	       const DATA_TYPE *B, int ldb)
+{
+  int i, j, k, kk;
+
+  for (i = i0; i < i1; i++)
+    for (j = j0; j < j1; j++)
+      C[i * ldc + j] *= beta;
+  for (kk = 0; kk < nk; kk += TILE_K)
+    for (i = i0; i < i1; i++)
+      for (k = kk; k < kk + TILE_K && k < nk; k++)
+	{
+	  DATA_TYPE a = alpha * A[i * lda + k];
+	  for (j = j0; j < j1; j++)
+	    C[i * ldc + j] += a * B[k * ldb + j];
+	}
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_gemm(int ni, int nj, int nk,
+		 DATA_TYPE alpha,
+		 DATA_TYPE beta,
+		 DATA_TYPE POLYBENCH_2D(C,NI,NJ,ni,nj),
+		 DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		 DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj))
+{
+  /* Row strides, padding included. */
+  const int ldc = (int) (&C[1][0] - &C[0][0]);
+  const int lda = (int) (&A[1][0] - &A[0][0]);
+  const int ldb = (int) (&B[1][0] - &B[0][0]);
+  const int tiles_j = (_PB_NJ + TILE_J - 1) / TILE_J;
+  const int nb_tiles = (_PB_NI + TILE_I - 1) / TILE_I * tiles_j;
+  polybench_steal_pool_t pool;
+
+  polybench_steal_init (&pool);
+
+//BLAS PARAMS
+//TRANSA = 'N'
+//TRANSB = 'N'
+// => Form C := alpha*A*B + beta*C,
+//A is NIxNK
+//B is NKxNJ
+//C is NIxNJ
+#pragma scop
+#pragma omp parallel
+  {
+    int t;
+#pragma omp single
+    polybench_steal_fill (&pool, nb_tiles);
+    while (polybench_steal_next (&pool, &t))
+      {
+	int i0 = t / tiles_j * TILE_I;
+	int j0 = t % tiles_j * TILE_J;
+	gemm_tile (i0, i0 + TILE_I < _PB_NI ? i0 + TILE_I : _PB_NI,
+		   j0, j0 + TILE_J < _PB_NJ ? j0 + TILE_J : _PB_NJ,
+		   _PB_NK, alpha, beta,
+		   &C[0][0], ldc, &A[0][0], lda, &B[0][0], ldb);
+      }
+  }
+#pragma endscop
+
+  polybench_steal_free (&pool);
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int ni = NI;
+  int nj = NJ;
+  int nk = NK;
+
+  /* Variable declaration/allocation. */
+  DATA_TYPE alpha;
+  DATA_TYPE beta;
+  POLYBENCH_2D_ARRAY_DECL(C,DATA_TYPE,NI,NJ,ni,nj);
+  POLYBENCH_2D_ARRAY_DECL(A,DATA_TYPE,NI,NK,ni,nk);
+  POLYBENCH_2D_ARRAY_DECL(B,DATA_TYPE,NK,NJ,nk,nj);
+
+  /* Initialize array(s). */
+  init_array (ni, nj, nk, &alpha, &beta,
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_gemm (ni, nj, nk,
+	       alpha, beta,
+	       POLYBENCH_ARRAY(C),
+	       POLYBENCH_ARRAY(A),
+	       POLYBENCH_ARRAY(B));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(ni, nj,  POLYBENCH_ARRAY(C)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(C);
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(B);
+
+  return 0;
+}
@@ -0,0 +1,215 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* gemver-fused.c: this file is part of PolyBench/C */
+
+/* gemver.c in two sweeps of A instead of three: the rank-2 update of A
+   and t := A^T y share the first one, x := x + beta t + z follows, and
+   the second computes A x for w. See polybench_matvec.h. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "gemver.h"
+
+#include <polybench_matvec.h>
+
+
+/* Array initialization. */
+static
+void init_array (int n,
+		 DATA_TYPE *alpha,
+		 DATA_TYPE *beta,
+		 DATA_TYPE POLYBENCH_2D(A,N,N,n,n),
+		 DATA_TYPE POLYBENCH_1D(u1,N,n),
+		 DATA_TYPE POLYBENCH_1D(v1,N,n),
+		 DATA_TYPE POLYBENCH_1D(u2,N,n),
+		 DATA_TYPE POLYBENCH_1D(v2,N,n),
+		 DATA_TYPE POLYBENCH_1D(w,N,n),
+		 DATA_TYPE POLYBENCH_1D(x,N,n),
+		 DATA_TYPE POLYBENCH_1D(y,N,n),
+		 DATA_TYPE POLYBENCH_1D(z,N,n))
+{
+  int i, j;
+
+  *alpha = 1.5;
+  *beta = 1.2;
+
+  DATA_TYPE fn = (DATA_TYPE)n;
+
+  for (i = 0; i < n; i++)
+    {
+      u1[i] = i;
+      u2[i] = ((i+1)/fn)/2.0;
+      v1[i] = ((i+1)/fn)/4.0;
+      v2[i] = ((i+1)/fn)/6.0;
+      y[i] = ((i+1)/fn)/8.0;
+      z[i] = ((i+1)/fn)/9.0;
+      x[i] = 0.0;
+      w[i] = 0.0;
+      for (j = 0; j < n; j++)
+        A[i][j] = (DATA_TYPE) (i*j % n) / n;
+    }
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int n,
+		 DATA_TYPE POLYBENCH_1D(w,N,n))
+{
+  int i;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("w");
+  for (i = 0; i < n; i++) {
+    if (i % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+    fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, w[i]);
+  }
+  POLYBENCH_DUMP_END("w");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_gemver(int n,
+		   DATA_TYPE alpha,
+		   DATA_TYPE beta,
+		   DATA_TYPE POLYBENCH_2D(A,N,N,n,n),
+		   DATA_TYPE POLYBENCH_1D(u1,N,n),
+		   DATA_TYPE POLYBENCH_1D(v1,N,n),
+		   DATA_TYPE POLYBENCH_1D(u2,N,n),
+		   DATA_TYPE POLYBENCH_1D(v2,N,n),
+		   DATA_TYPE POLYBENCH_1D(w,N,n),
+		   DATA_TYPE POLYBENCH_1D(x,N,n),
+		   DATA_TYPE POLYBENCH_1D(y,N,n),
+		   DATA_TYPE POLYBENCH_1D(z,N,n),
+		   DATA_TYPE POLYBENCH_1D(t,N,n))
+{
+  int i;
+  polybench_matvec_t mv = { 0 };
+
+  mv.m = _PB_N;
+  mv.n = _PB_N;
+  mv.A = &A[0][0];
+  mv.lda = (int) (&A[1][0] - &A[0][0]);
+
+#pragma scop
+
+  /* A := A + u1 v1^T + u2 v2^T and t := A^T y */
+  mv.u1 = u1;
+  mv.v1 = v1;
+  mv.u2 = u2;
+  mv.v2 = v2;
+  mv.w = y;
+  mv.z = t;
+  polybench_matvec (&mv);
+
+  for (i = 0; i < _PB_N; i++)
+    x[i] = x[i] + beta * t[i] + z[i];
+
+  /* t := A x */
+  mv.u1 = NULL;
+  mv.z = NULL;
+  mv.x = x;
+  mv.y = t;
+  polybench_matvec (&mv);
+
+  for (i = 0; i < _PB_N; i++)
+    w[i] = w[i] + alpha * t[i];
+
+#pragma endscop
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int n = N;
+
+  /* Variable declaration/allocation. */
+  DATA_TYPE alpha;
+  DATA_TYPE beta;
+  POLYBENCH_2D_ARRAY_DECL(A, DATA_TYPE, N, N, n, n);
+  POLYBENCH_1D_ARRAY_DECL(u1, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(v1, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(u2, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(v2, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(w, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(x, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(y, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(z, DATA_TYPE, N, n);
+  /* A^T y, then A x. */
+  POLYBENCH_1D_ARRAY_DECL(t, DATA_TYPE, N, n);
+
+
+  /* Initialize array(s). */
+  init_array (n, &alpha, &beta,
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(u1),
+	      POLYBENCH_ARRAY(v1),
+	      POLYBENCH_ARRAY(u2),
+	      POLYBENCH_ARRAY(v2),
+	      POLYBENCH_ARRAY(w),
+	      POLYBENCH_ARRAY(x),
+	      POLYBENCH_ARRAY(y),
+	      POLYBENCH_ARRAY(z));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_gemver (n, alpha, beta,
+		 POLYBENCH_ARRAY(A),
+		 POLYBENCH_ARRAY(u1),
+		 POLYBENCH_ARRAY(v1),
+		 POLYBENCH_ARRAY(u2),
+		 POLYBENCH_ARRAY(v2),
+		 POLYBENCH_ARRAY(w),
+		 POLYBENCH_ARRAY(x),
+		 POLYBENCH_ARRAY(y),
+		 POLYBENCH_ARRAY(z),
+		 POLYBENCH_ARRAY(t));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+#if defined(POLYBENCH_TIME) && defined(POLYBENCH_MATVEC_REPORT)
+  /* A read and written, then read again; the vectors */
+  polybench_matvec_report ("gemver", sizeof (DATA_TYPE) * (3.0 * n * n + 12 * n),
+			   polybench_timer_get_elapsed ());
+#endif
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(n, POLYBENCH_ARRAY(w)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(u1);
+  POLYBENCH_FREE_ARRAY(v1);
+  POLYBENCH_FREE_ARRAY(u2);
+  POLYBENCH_FREE_ARRAY(v2);
+  POLYBENCH_FREE_ARRAY(w);
+  POLYBENCH_FREE_ARRAY(x);
+  POLYBENCH_FREE_ARRAY(y);
+  POLYBENCH_FREE_ARRAY(z);
+  POLYBENCH_FREE_ARRAY(t);
+
+  return 0;
+}
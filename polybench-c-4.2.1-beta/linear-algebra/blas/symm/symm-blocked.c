@@ -0,0 +1,224 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* symm-blocked.c: this file is part of PolyBench/C */
+
+/* Blocked, multithreaded variant of symm.c. Instead of scattering into
+   the rows of C above the current one, A is first expanded into a full
+   symmetric matrix scaled by alpha, and C := beta * C + (alpha * A) * B
+   is then computed as a general product: C is split into TILE_I x TILE_J
+   tiles scheduled by the work-stealing pool of polybench_steal.h, each of
+   them accumulated in TILE_K slices with unit-stride rows of B. Build with
+   -O3 (the tile loop is cloned for AVX-512, AVX2 and the baseline ISA) and
+   -fopenmp. Results agree with symm.c up to rounding. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "symm.h"
+
+#include <polybench_steal.h>
+
+#ifndef TILE_I
+# define TILE_I 64
+#endif
+#ifndef TILE_J
+# define TILE_J 256
+#endif
+#ifndef TILE_K
+# define TILE_K 128
+#endif
+
+
+/* Array initialization. */
+static
+void init_array(int m, int n,
+		DATA_TYPE *alpha,
+		DATA_TYPE *beta,
+		DATA_TYPE POLYBENCH_2D(C,M,N,m,n),
+		DATA_TYPE POLYBENCH_2D(A,M,M,m,m),
+		DATA_TYPE POLYBENCH_2D(B,M,N,m,n))
+{
+  int i, j;
+
+  *alpha = 1.5;
+  *beta = 1.2;
+  for (i = 0; i < m; i++)
+    for (j = 0; j < n; j++) {
+      C[i][j] = (DATA_TYPE) ((i+j) % 100) / m;
+      B[i][j] = (DATA_TYPE) ((n+i-j) % 100) / m;
+    }
+  for (i = 0; i < m; i++) {
+    for (j = 0; j <=i; j++)
+      A[i][j] = (DATA_TYPE) ((i+j) % 100) / m;
+    for (j = i+1; j < m; j++)
+      A[i][j] = -999; //regions of arrays that should not be used
+  }
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int m, int n,
+		 DATA_TYPE POLYBENCH_2D(C,M,N,m,n))
+{
+  int i, j;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("C");
+  for (i = 0; i < m; i++)
+    for (j = 0; j < n; j++) {
+	if ((i * m + j) % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+	fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, C[i][j]);
+    }
+  POLYBENCH_DUMP_END("C");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* C[i0:i1][j0:j1] = beta * C + As[i0:i1][:] * B[:][j0:j1] */
+static POLYBENCH_ISA_CLONES
+void symm_tile(int i0, int i1, int j0, int j1, int m,
+	       DATA_TYPE beta,
+	       DATA_TYPE* POLYBENCH_RESTRICT C, int ldc,
+	       const DATA_TYPE* POLYBENCH_RESTRICT As, int lda,
+	       const DATA_TYPE* POLYBENCH_RESTRICT B, int ldb)
+{
+  int i, j, k, kk;
+
+  for (i = i0; i < i1; i++)
+    for (j = j0; j < j1; j++)
+      C[i * ldc + j] *= beta;
+  for (kk = 0; kk < m; kk += TILE_K)
+    for (i = i0; i < i1; i++)
+      for (k = kk; k < kk + TILE_K && k < m; k++)
+	{
+	  DATA_TYPE a = As[i * lda + k];
+	  for (j = j0; j < j1; j++)
+	    C[i * ldc + j] += a * B[k * ldb + j];
+	}
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_symm(int m, int n,
+		 DATA_TYPE alpha,
+		 DATA_TYPE beta,
+		 DATA_TYPE POLYBENCH_2D(C,M,N,m,n),
+		 DATA_TYPE POLYBENCH_2D(A,M,M,m,m),
+		 DATA_TYPE POLYBENCH_2D(B,M,N,m,n),
+		 DATA_TYPE POLYBENCH_2D(As,M,M,m,m))
+{
+  /* Row strides, padding included. */
+  const int ldc = (int) (&C[1][0] - &C[0][0]);
+  const int lda = (int) (&As[1][0] - &As[0][0]);
+  const int ldb = (int) (&B[1][0] - &B[0][0]);
+  const int tiles_j = (_PB_N + TILE_J - 1) / TILE_J;
+  const int nb_tiles = (_PB_M + TILE_I - 1) / TILE_I * tiles_j;
+  polybench_steal_pool_t pool;
+
+  polybench_steal_init (&pool);
+
+//BLAS PARAMS
+//SIDE = 'L'
+//UPLO = 'L'
+// =>  Form  C := alpha*A*B + beta*C
+// A is MxM
+// B is MxN
+// C is MxN
+#pragma scop
+#pragma omp parallel
+  {
+    int i, k, kk, t;
+    /* As = alpha * A, the lower triangle of A mirrored above the
+       diagonal by slices of rows */
+#pragma omp for schedule(dynamic, 16)
+    for (i = 0; i < _PB_M; i++)
+      for (k = 0; k <= i; k++)
+	As[i][k] = alpha * A[i][k];
+#pragma omp for schedule(dynamic, 1)
+    for (kk = 0; kk < _PB_M; kk += 32)
+      for (i = kk + 1; i < _PB_M; i++)
+	for (k = kk; k < kk + 32 && k < i; k++)
+	  As[k][i] = alpha * A[i][k];
+#pragma omp single
+    polybench_steal_fill (&pool, nb_tiles);
+    while (polybench_steal_next (&pool, &t))
+      {
+	int i0 = t / tiles_j * TILE_I;
+	int j0 = t % tiles_j * TILE_J;
+	symm_tile (i0, i0 + TILE_I < _PB_M ? i0 + TILE_I : _PB_M,
+		   j0, j0 + TILE_J < _PB_N ? j0 + TILE_J : _PB_N,
+		   _PB_M, beta,
+		   &C[0][0], ldc, &As[0][0], lda, &B[0][0], ldb);
+      }
+  }
+#pragma endscop
+
+  polybench_steal_free (&pool);
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int m = M;
+  int n = N;
+
+  /* Variable declaration/allocation. */
+  DATA_TYPE alpha;
+  DATA_TYPE beta;
+  POLYBENCH_2D_ARRAY_DECL(C,DATA_TYPE,M,N,m,n);
+  POLYBENCH_2D_ARRAY_DECL(A,DATA_TYPE,M,M,m,m);
+  POLYBENCH_2D_ARRAY_DECL(B,DATA_TYPE,M,N,m,n);
+  /* alpha * A, both triangles. */
+  POLYBENCH_2D_ARRAY_DECL(As,DATA_TYPE,M,M,m,m);
+
+  /* Initialize array(s). */
+  init_array (m, n, &alpha, &beta,
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_symm (m, n,
+	       alpha, beta,
+	       POLYBENCH_ARRAY(C),
+	       POLYBENCH_ARRAY(A),
+	       POLYBENCH_ARRAY(B),
+	       POLYBENCH_ARRAY(As));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(m, n, POLYBENCH_ARRAY(C)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(C);
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(B);
+  POLYBENCH_FREE_ARRAY(As);
+
+  return 0;
+}
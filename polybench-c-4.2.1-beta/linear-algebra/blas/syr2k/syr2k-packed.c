@@ -0,0 +1,264 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* syr2k-packed.c: this file is part of PolyBench/C */
+
+/* Blocked, multithreaded variant of syr2k.c. A and B are packed
+   transposed and scaled by alpha, so that the updates of a row of C are
+   unit-stride, and the lower triangle of C is computed in a compact,
+   row-packed copy. TRI_TB x TRI_TB tiles of the triangle are scheduled by
+   the work-stealing pool of polybench_steal.h, their rows interleaved for
+   balance. Build with -O3 (the tile loop is cloned for AVX-512, AVX2 and
+   the baseline ISA) and -fopenmp. Every element is accumulated in the
+   order of syr2k.c. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "syr2k.h"
+
+#include <polybench_steal.h>
+
+/* Square tiles of the triangle, and the k slices computed at once. */
+#ifndef TRI_TB
+# define TRI_TB 64
+#endif
+#ifndef TRI_KB
+# define TRI_KB 128
+#endif
+
+
+/* Array initialization. */
+static
+void init_array(int n, int m,
+		DATA_TYPE *alpha,
+		DATA_TYPE *beta,
+		DATA_TYPE POLYBENCH_2D(C,N,N,n,n),
+		DATA_TYPE POLYBENCH_2D(A,N,M,n,m),
+		DATA_TYPE POLYBENCH_2D(B,N,M,n,m))
+{
+  int i, j;
+
+  *alpha = 1.5;
+  *beta = 1.2;
+  for (i = 0; i < n; i++)
+    for (j = 0; j < m; j++) {
+      A[i][j] = (DATA_TYPE) ((i*j+1)%n) / n;
+      B[i][j] = (DATA_TYPE) ((i*j+2)%m) / m;
+    }
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++) {
+      C[i][j] = (DATA_TYPE) ((i*j+3)%n) / m;
+    }
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int n,
+		 DATA_TYPE POLYBENCH_2D(C,N,N,n,n))
+{
+  int i, j;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("C");
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++) {
+	if ((i * n + j) % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+	fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, C[i][j]);
+    }
+  POLYBENCH_DUMP_END("C");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* Block row of the r-th tile row, in the order 0, nb-1, 1, nb-2, ...:
+   consecutive block rows of the lower triangle pair a short one with a
+   long one, so that the contiguous ranges the pool starts with carry the
+   same work. */
+static
+int zigzag(int r, int nb)
+{
+  return r % 2 ? nb - 1 - r / 2 : r / 2;
+}
+
+/* Tiles (bi, bj), bj <= bi, of the lower triangle of nb x nb blocks. */
+static
+int* lower_tiles(int nb)
+{
+  int* tiles = (int*) malloc (nb * (nb + 1) * sizeof (int));
+  int r, bj, t = 0;
+
+  for (r = 0; r < nb; r++)
+    for (bj = 0; bj <= zigzag (r, nb); bj++)
+      {
+	tiles[t++] = zigzag (r, nb);
+	tiles[t++] = bj;
+      }
+  return tiles;
+}
+
+
+/* Rows i0..i1 and columns j0..j1 (j <= i) of the packed triangle
+   Cp += alpha * (A * B^T + B * A^T), Ata and Bta being A and B
+   transposed and scaled by alpha. */
+static POLYBENCH_ISA_CLONES
+void syr2k_tile(int i0, int i1, int j0, int j1, int m, int n,
+		const DATA_TYPE* A, const DATA_TYPE* B, int ld,
+		const DATA_TYPE* POLYBENCH_RESTRICT Ata,
+		const DATA_TYPE* POLYBENCH_RESTRICT Bta,
+		DATA_TYPE* POLYBENCH_RESTRICT Cp)
+{
+  int i, j, k, kk;
+
+  for (kk = 0; kk < m; kk += TRI_KB)
+    for (i = i0; i < i1; i++)
+      {
+	DATA_TYPE* c = Cp + (long) i * (i + 1) / 2;
+	int je = j1 < i + 1 ? j1 : i + 1;
+	for (k = kk; k < kk + TRI_KB && k < m; k++)
+	  {
+	    DATA_TYPE a = A[i * ld + k], b = B[i * ld + k];
+	    const DATA_TYPE* at = Ata + (long) k * n;
+	    const DATA_TYPE* bt = Bta + (long) k * n;
+	    for (j = j0; j < je; j++)
+	      c[j] += at[j] * b + bt[j] * a;
+	  }
+      }
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_syr2k(int n, int m,
+		  DATA_TYPE alpha,
+		  DATA_TYPE beta,
+		  DATA_TYPE POLYBENCH_2D(C,N,N,n,n),
+		  DATA_TYPE POLYBENCH_2D(A,N,M,n,m),
+		  DATA_TYPE POLYBENCH_2D(B,N,M,n,m),
+		  DATA_TYPE* Ata,
+		  DATA_TYPE* Bta,
+		  DATA_TYPE* Cp)
+{
+  const int ld = (int) (&A[1][0] - &A[0][0]);
+  const int nb = (_PB_N + TRI_TB - 1) / TRI_TB;
+  int* tiles = lower_tiles (nb);
+  polybench_steal_pool_t pool;
+
+  polybench_steal_init (&pool);
+
+//BLAS PARAMS
+//UPLO  = 'L'
+//TRANS = 'N'
+//A is NxM
+//B is NxM
+//C is NxN
+#pragma scop
+#pragma omp parallel
+  {
+    int i, j, k, kk, t;
+    /* alpha * A^T and alpha * B^T, by slices of k; Cp := beta * the
+       lower triangle of C */
+#pragma omp for schedule(static)
+    for (kk = 0; kk < _PB_M; kk += 32)
+      for (j = 0; j < _PB_N; j++)
+	for (k = kk; k < kk + 32 && k < _PB_M; k++)
+	  {
+	    Ata[(long) k * _PB_N + j] = A[j][k] * alpha;
+	    Bta[(long) k * _PB_N + j] = B[j][k] * alpha;
+	  }
+#pragma omp for schedule(dynamic, 16)
+    for (i = 0; i < _PB_N; i++)
+      for (j = 0; j <= i; j++)
+	Cp[(long) i * (i + 1) / 2 + j] = C[i][j] * beta;
+#pragma omp single
+    polybench_steal_fill (&pool, nb * (nb + 1) / 2);
+    while (polybench_steal_next (&pool, &t))
+      {
+	int i0 = tiles[2 * t] * TRI_TB, j0 = tiles[2 * t + 1] * TRI_TB;
+	syr2k_tile (i0, i0 + TRI_TB < _PB_N ? i0 + TRI_TB : _PB_N,
+		    j0, j0 + TRI_TB, _PB_M, _PB_N,
+		    &A[0][0], &B[0][0], ld, Ata, Bta, Cp);
+      }
+#pragma omp barrier
+#pragma omp for schedule(dynamic, 16)
+    for (i = 0; i < _PB_N; i++)
+      for (j = 0; j <= i; j++)
+	C[i][j] = Cp[(long) i * (i + 1) / 2 + j];
+  }
+#pragma endscop
+
+  polybench_steal_free (&pool);
+  free (tiles);
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int n = N;
+  int m = M;
+
+  /* Variable declaration/allocation. */
+  DATA_TYPE alpha;
+  DATA_TYPE beta;
+  POLYBENCH_2D_ARRAY_DECL(C,DATA_TYPE,N,N,n,n);
+  POLYBENCH_2D_ARRAY_DECL(A,DATA_TYPE,N,M,n,m);
+  POLYBENCH_2D_ARRAY_DECL(B,DATA_TYPE,N,M,n,m);
+  /* alpha * A and alpha * B transposed, and the packed lower triangle
+     of C. */
+  POLYBENCH_1D_ARRAY_DECL(Ata,DATA_TYPE,M*N,m*n);
+  POLYBENCH_1D_ARRAY_DECL(Bta,DATA_TYPE,M*N,m*n);
+  POLYBENCH_1D_ARRAY_DECL(Cp,DATA_TYPE,N*(N+1)/2,n*(n+1)/2);
+
+  /* Initialize array(s). */
+  init_array (n, m, &alpha, &beta,
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_syr2k (n, m,
+		alpha, beta,
+		POLYBENCH_ARRAY(C),
+		POLYBENCH_ARRAY(A),
+		POLYBENCH_ARRAY(B),
+		POLYBENCH_ARRAY(Ata),
+		POLYBENCH_ARRAY(Bta),
+		POLYBENCH_ARRAY(Cp));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(n, POLYBENCH_ARRAY(C)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(C);
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(B);
+  POLYBENCH_FREE_ARRAY(Ata);
+  POLYBENCH_FREE_ARRAY(Bta);
+  POLYBENCH_FREE_ARRAY(Cp);
+
+  return 0;
+}
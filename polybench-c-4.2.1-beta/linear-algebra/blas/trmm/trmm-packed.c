@@ -0,0 +1,225 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* trmm-packed.c: this file is part of PolyBench/C */
+
+/* Blocked, multithreaded variant of trmm.c. The strict lower triangle of
+   A is packed by columns (row i of the packed triangle holds A[i+1..m-1][i]),
+   turning the strided walk down a column of A into a unit-stride one.
+   Rows of the result are computed into a copy of B, so that tiles of
+   TRI_TB rows x TRI_TN columns are independent; they are scheduled by
+   the work-stealing pool of polybench_steal.h, long and short rows
+   interleaved for balance. Build with -O3 (the tile loop is cloned for
+   AVX-512, AVX2 and the baseline ISA) and -fopenmp. Every element is
+   accumulated in the order of trmm.c. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "trmm.h"
+
+#include <polybench_steal.h>
+
+/* Square tiles of the triangle, and the k slices computed at once. */
+#ifndef TRI_TB
+# define TRI_TB 64
+#endif
+#ifndef TRI_KB
+# define TRI_KB 128
+#endif
+#ifndef TRI_TN
+# define TRI_TN 256
+#endif
+
+/* Start of row i of the packed strict lower triangle of a m x m matrix,
+   row i holding m-1-i elements. */
+#define PACKED_ROW(i, m) ((long) (i) * ((m) - 1) - (long) (i) * ((i) - 1) / 2)
+
+
+/* Array initialization. */
+static
+void init_array(int m, int n,
+		DATA_TYPE *alpha,
+		DATA_TYPE POLYBENCH_2D(A,M,M,m,m),
+		DATA_TYPE POLYBENCH_2D(B,M,N,m,n))
+{
+  int i, j;
+
+  *alpha = 1.5;
+  for (i = 0; i < m; i++) {
+    for (j = 0; j < i; j++) {
+      A[i][j] = (DATA_TYPE)((i+j) % m)/m;
+    }
+    A[i][i] = 1.0;
+    for (j = 0; j < n; j++) {
+      B[i][j] = (DATA_TYPE)((n+(i-j)) % n)/n;
+    }
+ }
+
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int m, int n,
+		 DATA_TYPE POLYBENCH_2D(B,M,N,m,n))
+{
+  int i, j;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("B");
+  for (i = 0; i < m; i++)
+    for (j = 0; j < n; j++) {
+	if ((i * m + j) % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+	fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, B[i][j]);
+    }
+  POLYBENCH_DUMP_END("B");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* Block row of the r-th tile row, in the order 0, nb-1, 1, nb-2, ...:
+   consecutive block rows of the lower triangle pair a short one with a
+   long one, so that the contiguous ranges the pool starts with carry the
+   same work. */
+static
+int zigzag(int r, int nb)
+{
+  return r % 2 ? nb - 1 - r / 2 : r / 2;
+}
+
+/* Rows i0..i1, columns j0..j1 of Bo := alpha * (B + A^T * B), A being
+   unit lower triangular, its strict lower part packed by columns in Ap. */
+static POLYBENCH_ISA_CLONES
+void trmm_tile(int i0, int i1, int j0, int j1, int m,
+	       DATA_TYPE alpha,
+	       const DATA_TYPE* POLYBENCH_RESTRICT Ap,
+	       const DATA_TYPE* B, int ldb,
+	       DATA_TYPE* POLYBENCH_RESTRICT Bo)
+{
+  int i, j, k, kk;
+
+  for (i = i0; i < i1; i++)
+    for (j = j0; j < j1; j++)
+      Bo[i * ldb + j] = B[i * ldb + j];
+  for (kk = i0 + 1; kk < m; kk += TRI_KB)
+    for (i = i0; i < i1; i++)
+      for (k = kk > i + 1 ? kk : i + 1; k < kk + TRI_KB && k < m; k++)
+	{
+	  DATA_TYPE a = Ap[PACKED_ROW (i, m) + k - i - 1];
+	  for (j = j0; j < j1; j++)
+	    Bo[i * ldb + j] += a * B[k * ldb + j];
+	}
+  for (i = i0; i < i1; i++)
+    for (j = j0; j < j1; j++)
+      Bo[i * ldb + j] = alpha * Bo[i * ldb + j];
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_trmm(int m, int n,
+		 DATA_TYPE alpha,
+		 DATA_TYPE POLYBENCH_2D(A,M,M,m,m),
+		 DATA_TYPE POLYBENCH_2D(B,M,N,m,n),
+		 DATA_TYPE POLYBENCH_2D(Bo,M,N,m,n),
+		 DATA_TYPE* Ap)
+{
+  const int ldb = (int) (&B[1][0] - &B[0][0]);
+  const int nbr = (_PB_M + TRI_TB - 1) / TRI_TB;
+  const int nbc = (_PB_N + TRI_TN - 1) / TRI_TN;
+  polybench_steal_pool_t pool;
+
+  polybench_steal_init (&pool);
+
+//BLAS parameters
+//SIDE   = 'L'
+//UPLO   = 'L'
+//TRANSA = 'T'
+//DIAG   = 'U'
+// => Form  B := alpha*A**T*B.
+// A is MxM
+// B is MxN
+#pragma scop
+#pragma omp parallel
+  {
+    int i, j, k, t;
+#pragma omp for schedule(dynamic, 16)
+    for (i = 0; i < _PB_M; i++)
+      for (k = i + 1; k < _PB_M; k++)
+	Ap[PACKED_ROW (i, _PB_M) + k - i - 1] = A[k][i];
+#pragma omp single
+    polybench_steal_fill (&pool, nbr * nbc);
+    while (polybench_steal_next (&pool, &t))
+      {
+	int i0 = zigzag (t / nbc, nbr) * TRI_TB, j0 = t % nbc * TRI_TN;
+	trmm_tile (i0, i0 + TRI_TB < _PB_M ? i0 + TRI_TB : _PB_M,
+		   j0, j0 + TRI_TN < _PB_N ? j0 + TRI_TN : _PB_N,
+		   _PB_M, alpha, Ap, &B[0][0], ldb, &Bo[0][0]);
+      }
+#pragma omp barrier
+#pragma omp for schedule(static)
+    for (i = 0; i < _PB_M; i++)
+      for (j = 0; j < _PB_N; j++)
+	B[i][j] = Bo[i][j];
+  }
+#pragma endscop
+
+  polybench_steal_free (&pool);
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int m = M;
+  int n = N;
+
+  /* Variable declaration/allocation. */
+  DATA_TYPE alpha;
+  POLYBENCH_2D_ARRAY_DECL(A,DATA_TYPE,M,M,m,m);
+  POLYBENCH_2D_ARRAY_DECL(B,DATA_TYPE,M,N,m,n);
+  /* The result, and the packed strict lower triangle of A. */
+  POLYBENCH_2D_ARRAY_DECL(Bo,DATA_TYPE,M,N,m,n);
+  POLYBENCH_1D_ARRAY_DECL(Ap,DATA_TYPE,M*(M-1)/2+1,m*(m-1)/2+1);
+
+  /* Initialize array(s). */
+  init_array (m, n, &alpha, POLYBENCH_ARRAY(A), POLYBENCH_ARRAY(B));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_trmm (m, n, alpha, POLYBENCH_ARRAY(A), POLYBENCH_ARRAY(B),
+	       POLYBENCH_ARRAY(Bo), POLYBENCH_ARRAY(Ap));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(m, n, POLYBENCH_ARRAY(B)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(B);
+  POLYBENCH_FREE_ARRAY(Bo);
+  POLYBENCH_FREE_ARRAY(Ap);
+
+  return 0;
+}
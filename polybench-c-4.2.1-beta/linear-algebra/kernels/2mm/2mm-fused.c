@@ -0,0 +1,185 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* 2mm-fused.c: this file is part of PolyBench/C */
+
+/* Variant of 2mm.c evaluating D := alpha*A*B*C + beta*D with the chain
+   engine of polybench_chain.h: the cheapest multiplication order for the
+   dimensions, with row panels of the intermediate product kept in cache
+   instead of the whole tmp array. With -DPOLYBENCH_TIME, the chosen order
+   and the modelled memory traffic, against the one of 2mm.c, are printed
+   after the time. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "2mm.h"
+
+#include <polybench_chain.h>
+
+
+/* Array initialization. */
+static
+void init_array(int ni, int nj, int nk, int nl,
+		DATA_TYPE *alpha,
+		DATA_TYPE *beta,
+		DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj),
+		DATA_TYPE POLYBENCH_2D(C,NJ,NL,nj,nl),
+		DATA_TYPE POLYBENCH_2D(D,NI,NL,ni,nl))
+{
+  int i, j;
+
+  *alpha = 1.5;
+  *beta = 1.2;
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nk; j++)
+      A[i][j] = (DATA_TYPE) ((i*j+1) % ni) / ni;
+  for (i = 0; i < nk; i++)
+    for (j = 0; j < nj; j++)
+      B[i][j] = (DATA_TYPE) (i*(j+1) % nj) / nj;
+  for (i = 0; i < nj; i++)
+    for (j = 0; j < nl; j++)
+      C[i][j] = (DATA_TYPE) ((i*(j+3)+1) % nl) / nl;
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nl; j++)
+      D[i][j] = (DATA_TYPE) (i*(j+2) % nk) / nk;
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int ni, int nl,
+		 DATA_TYPE POLYBENCH_2D(D,NI,NL,ni,nl))
+{
+  int i, j;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("D");
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nl; j++) {
+	if ((i * ni + j) % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+	fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, D[i][j]);
+    }
+  POLYBENCH_DUMP_END("D");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* Chain A*B*C in the order of 2mm.c, ((AB)C), or the cheapest one. */
+static
+void make_plan(polybench_chain_plan_t* plan, int optimal,
+	       int ni, int nj, int nk, int nl)
+{
+  plan->n = 3;
+  plan->dims[0] = ni;
+  plan->dims[1] = nk;
+  plan->dims[2] = nj;
+  plan->dims[3] = nl;
+  plan->split[0][1] = 0;
+  plan->split[1][2] = 1;
+  plan->split[0][2] = 1;
+  if (optimal)
+    polybench_chain_optimize (plan);
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_2mm(int ni, int nj, int nk, int nl,
+		DATA_TYPE alpha,
+		DATA_TYPE beta,
+		DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj),
+		DATA_TYPE POLYBENCH_2D(C,NJ,NL,nj,nl),
+		DATA_TYPE POLYBENCH_2D(D,NI,NL,ni,nl))
+{
+  const DATA_TYPE* mat[3] = { &A[0][0], &B[0][0], &C[0][0] };
+  /* Row strides, padding included. */
+  const int ld[3] = { (int) (&A[1][0] - &A[0][0]),
+		      (int) (&B[1][0] - &B[0][0]),
+		      (int) (&C[1][0] - &C[0][0]) };
+  polybench_chain_plan_t plan;
+
+#pragma scop
+  /* D := alpha*A*B*C + beta*D */
+  make_plan (&plan, 1, _PB_NI, _PB_NJ, _PB_NK, _PB_NL);
+  polybench_chain_run (&plan, mat, ld, alpha, beta, 1,
+		       &D[0][0], (int) (&D[1][0] - &D[0][0]));
+#pragma endscop
+
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int ni = NI;
+  int nj = NJ;
+  int nk = NK;
+  int nl = NL;
+
+  /* Variable declaration/allocation. */
+  DATA_TYPE alpha;
+  DATA_TYPE beta;
+  POLYBENCH_2D_ARRAY_DECL(A,DATA_TYPE,NI,NK,ni,nk);
+  POLYBENCH_2D_ARRAY_DECL(B,DATA_TYPE,NK,NJ,nk,nj);
+  POLYBENCH_2D_ARRAY_DECL(C,DATA_TYPE,NJ,NL,nj,nl);
+  POLYBENCH_2D_ARRAY_DECL(D,DATA_TYPE,NI,NL,ni,nl);
+
+  /* Initialize array(s). */
+  init_array (ni, nj, nk, nl, &alpha, &beta,
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B),
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(D));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_2mm (ni, nj, nk, nl,
+	      alpha, beta,
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B),
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(D));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+#ifdef POLYBENCH_TIME
+  {
+    polybench_chain_plan_t plan, ref;
+    make_plan (&plan, 1, ni, nj, nk, nl);
+    make_plan (&ref, 0, ni, nj, nk, nl);
+    polybench_chain_report (&plan, &ref, "ABC");
+  }
+#endif
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(ni, nl,  POLYBENCH_ARRAY(D)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(B);
+  POLYBENCH_FREE_ARRAY(C);
+  POLYBENCH_FREE_ARRAY(D);
+
+  return 0;
+}
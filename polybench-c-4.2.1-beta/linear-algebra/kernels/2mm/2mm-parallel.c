@@ -0,0 +1,222 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* 2mm-parallel.c: this file is part of PolyBench/C */
+
+/* Multithreaded variant of 2mm.c: tmp, then D, are split into
+   TILE_I x TILE_J tiles scheduled by the work-stealing pool of
+   polybench_steal.h. Build with -fopenmp, and -DPOLYBENCH_THREADS=N to
+   set the number of threads. Every element is accumulated in the order
+   of 2mm.c. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "2mm.h"
+
+#include <polybench_steal.h>
+
+#ifndef TILE_I
+# define TILE_I 64
+#endif
+#ifndef TILE_J
+# define TILE_J 256
+#endif
+#ifndef TILE_K
+# define TILE_K 128
+#endif
+
+
+/* Array initialization. */
+static
+void init_array(int ni, int nj, int nk, int nl,
+		DATA_TYPE *alpha,
+		DATA_TYPE *beta,
+		DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj),
+		DATA_TYPE POLYBENCH_2D(C,NJ,NL,nj,nl),
+		DATA_TYPE POLYBENCH_2D(D,NI,NL,ni,nl))
+{
+  int i, j;
+
+  *alpha = 1.5;
+  *beta = 1.2;
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nk; j++)
+      A[i][j] = (DATA_TYPE) ((i*j+1) % ni) / ni;
+  for (i = 0; i < nk; i++)
+    for (j = 0; j < nj; j++)
+      B[i][j] = (DATA_TYPE) (i*(j+1) % nj) / nj;
+  for (i = 0; i < nj; i++)
+    for (j = 0; j < nl; j++)
+      C[i][j] = (DATA_TYPE) ((i*(j+3)+1) % nl) / nl;
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nl; j++)
+      D[i][j] = (DATA_TYPE) (i*(j+2) % nk) / nk;
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int ni, int nl,
+		 DATA_TYPE POLYBENCH_2D(D,NI,NL,ni,nl))
+{
+  int i, j;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("D");
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nl; j++) {
+	if ((i * ni + j) % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+	fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, D[i][j]);
+    }
+  POLYBENCH_DUMP_END("D");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* X[i0:i1][j0:j1] = beta * X (0 without scale) + alpha * Y[i0:i1][:] * Z[:][j0:j1] */
+static
+void mm_tile(int i0, int i1, int j0, int j1, int nk,
+	     DATA_TYPE alpha, DATA_TYPE beta, int scale,
+	     DATA_TYPE *X, int ldx,
+	     const DATA_TYPE *Y, int ldy,
+	     const DATA_TYPE *Z, int ldz)
+{
+  int i, j, k, kk;
+
+  for (i = i0; i < i1; i++)
+    for (j = j0; j < j1; j++)
+      X[i * ldx + j] = scale ? X[i * ldx + j] * beta : SCALAR_VAL(0.0);
+  for (kk = 0; kk < nk; kk += TILE_K)
+    for (i = i0; i < i1; i++)
+      for (k = kk; k < kk + TILE_K && k < nk; k++)
+	{
+	  DATA_TYPE y = alpha * Y[i * ldy + k];
+	  for (j = j0; j < j1; j++)
+	    X[i * ldx + j] += y * Z[k * ldz + j];
+	}
+}
+
+/* Row stride of a 2D PolyBench array, padding included. */
+#define LD(X) ((int) (&X[1][0] - &X[0][0]))
+/* Tiles of a ni x nj array. */
+#define NB_TILES(ni, nj) \
+  (((ni) + TILE_I - 1) / TILE_I * (((nj) + TILE_J - 1) / TILE_J))
+/* Tile t of X := beta * X + alpha * Y * Z, X being ni x nj. */
+#define RUN_TILE(t, ni, nj, nk, alpha, beta, scale, X, Y, Z)		\
+  do {									\
+    int tiles_j_ = ((nj) + TILE_J - 1) / TILE_J;			\
+    int i0_ = (t) / tiles_j_ * TILE_I;					\
+    int j0_ = (t) % tiles_j_ * TILE_J;					\
+    mm_tile (i0_, i0_ + TILE_I < (ni) ? i0_ + TILE_I : (ni),		\
+	     j0_, j0_ + TILE_J < (nj) ? j0_ + TILE_J : (nj),		\
+	     (nk), (alpha), (beta), (scale),				\
+	     &X[0][0], LD(X), &Y[0][0], LD(Y), &Z[0][0], LD(Z));	\
+  } while (0)
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_2mm(int ni, int nj, int nk, int nl,
+		DATA_TYPE alpha,
+		DATA_TYPE beta,
+		DATA_TYPE POLYBENCH_2D(tmp,NI,NJ,ni,nj),
+		DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj),
+		DATA_TYPE POLYBENCH_2D(C,NJ,NL,nj,nl),
+		DATA_TYPE POLYBENCH_2D(D,NI,NL,ni,nl))
+{
+  polybench_steal_pool_t pool;
+
+  polybench_steal_init (&pool);
+
+#pragma scop
+  /* D := alpha*A*B*C + beta*D */
+#pragma omp parallel
+  {
+    int t;
+#pragma omp single
+    polybench_steal_fill (&pool, NB_TILES(_PB_NI, _PB_NJ));
+    while (polybench_steal_next (&pool, &t))
+      RUN_TILE (t, _PB_NI, _PB_NJ, _PB_NK, alpha, beta, 0, tmp, A, B);
+    /* D needs whole rows of tmp */
+#pragma omp barrier
+#pragma omp single
+    polybench_steal_fill (&pool, NB_TILES(_PB_NI, _PB_NL));
+    while (polybench_steal_next (&pool, &t))
+      RUN_TILE (t, _PB_NI, _PB_NL, _PB_NJ, SCALAR_VAL(1.0), beta, 1, D, tmp, C);
+  }
+#pragma endscop
+
+  polybench_steal_free (&pool);
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int ni = NI;
+  int nj = NJ;
+  int nk = NK;
+  int nl = NL;
+
+  /* Variable declaration/allocation. */
+  DATA_TYPE alpha;
+  DATA_TYPE beta;
+  POLYBENCH_2D_ARRAY_DECL(tmp,DATA_TYPE,NI,NJ,ni,nj);
+  POLYBENCH_2D_ARRAY_DECL(A,DATA_TYPE,NI,NK,ni,nk);
+  POLYBENCH_2D_ARRAY_DECL(B,DATA_TYPE,NK,NJ,nk,nj);
+  POLYBENCH_2D_ARRAY_DECL(C,DATA_TYPE,NJ,NL,nj,nl);
+  POLYBENCH_2D_ARRAY_DECL(D,DATA_TYPE,NI,NL,ni,nl);
+
+  /* Initialize array(s). */
+  init_array (ni, nj, nk, nl, &alpha, &beta,
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B),
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(D));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_2mm (ni, nj, nk, nl,
+	      alpha, beta,
+	      POLYBENCH_ARRAY(tmp),
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B),
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(D));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(ni, nl,  POLYBENCH_ARRAY(D)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(tmp);
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(B);
+  POLYBENCH_FREE_ARRAY(C);
+  POLYBENCH_FREE_ARRAY(D);
+
+  return 0;
+}
@@ -0,0 +1,183 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* 3mm-fused.c: this file is part of PolyBench/C */
+
+/* Variant of 3mm.c evaluating G := A*B*C*D with the chain engine of
+   polybench_chain.h: the cheapest multiplication order for the
+   dimensions, rather than (AB)(CD), with row panels of the intermediate
+   products kept in cache instead of the whole E and F arrays. With
+   -DPOLYBENCH_TIME, the chosen order and the modelled memory traffic,
+   against the one of 3mm.c, are printed after the time. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "3mm.h"
+
+#include <polybench_chain.h>
+
+
+/* Array initialization. */
+static
+void init_array(int ni, int nj, int nk, int nl, int nm,
+		DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj),
+		DATA_TYPE POLYBENCH_2D(C,NJ,NM,nj,nm),
+		DATA_TYPE POLYBENCH_2D(D,NM,NL,nm,nl))
+{
+  int i, j;
+
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nk; j++)
+      A[i][j] = (DATA_TYPE) ((i*j+1) % ni) / (5*ni);
+  for (i = 0; i < nk; i++)
+    for (j = 0; j < nj; j++)
+      B[i][j] = (DATA_TYPE) ((i*(j+1)+2) % nj) / (5*nj);
+  for (i = 0; i < nj; i++)
+    for (j = 0; j < nm; j++)
+      C[i][j] = (DATA_TYPE) (i*(j+3) % nl) / (5*nl);
+  for (i = 0; i < nm; i++)
+    for (j = 0; j < nl; j++)
+      D[i][j] = (DATA_TYPE) ((i*(j+2)+2) % nk) / (5*nk);
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int ni, int nl,
+		 DATA_TYPE POLYBENCH_2D(G,NI,NL,ni,nl))
+{
+  int i, j;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("G");
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nl; j++) {
+	if ((i * ni + j) % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+	fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, G[i][j]);
+    }
+  POLYBENCH_DUMP_END("G");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* Chain A*B*C*D in the order of 3mm.c, ((AB)(CD)), or the cheapest one. */
+static
+void make_plan(polybench_chain_plan_t* plan, int optimal,
+	       int ni, int nj, int nk, int nl, int nm)
+{
+  plan->n = 4;
+  plan->dims[0] = ni;
+  plan->dims[1] = nk;
+  plan->dims[2] = nj;
+  plan->dims[3] = nm;
+  plan->dims[4] = nl;
+  plan->split[0][1] = 0;
+  plan->split[2][3] = 2;
+  plan->split[0][3] = 1;
+  if (optimal)
+    polybench_chain_optimize (plan);
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_3mm(int ni, int nj, int nk, int nl, int nm,
+		DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj),
+		DATA_TYPE POLYBENCH_2D(C,NJ,NM,nj,nm),
+		DATA_TYPE POLYBENCH_2D(D,NM,NL,nm,nl),
+		DATA_TYPE POLYBENCH_2D(G,NI,NL,ni,nl))
+{
+  const DATA_TYPE* mat[4] = { &A[0][0], &B[0][0], &C[0][0], &D[0][0] };
+  /* Row strides, padding included. */
+  const int ld[4] = { (int) (&A[1][0] - &A[0][0]),
+		      (int) (&B[1][0] - &B[0][0]),
+		      (int) (&C[1][0] - &C[0][0]),
+		      (int) (&D[1][0] - &D[0][0]) };
+  polybench_chain_plan_t plan;
+
+#pragma scop
+  /* G := A*B*C*D */
+  make_plan (&plan, 1, _PB_NI, _PB_NJ, _PB_NK, _PB_NL, _PB_NM);
+  polybench_chain_run (&plan, mat, ld, SCALAR_VAL(1.0), SCALAR_VAL(0.0), 0,
+		       &G[0][0], (int) (&G[1][0] - &G[0][0]));
+#pragma endscop
+
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int ni = NI;
+  int nj = NJ;
+  int nk = NK;
+  int nl = NL;
+  int nm = NM;
+
+  /* Variable declaration/allocation. */
+  POLYBENCH_2D_ARRAY_DECL(A, DATA_TYPE, NI, NK, ni, nk);
+  POLYBENCH_2D_ARRAY_DECL(B, DATA_TYPE, NK, NJ, nk, nj);
+  POLYBENCH_2D_ARRAY_DECL(C, DATA_TYPE, NJ, NM, nj, nm);
+  POLYBENCH_2D_ARRAY_DECL(D, DATA_TYPE, NM, NL, nm, nl);
+  POLYBENCH_2D_ARRAY_DECL(G, DATA_TYPE, NI, NL, ni, nl);
+
+  /* Initialize array(s). */
+  init_array (ni, nj, nk, nl, nm,
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B),
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(D));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_3mm (ni, nj, nk, nl, nm,
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B),
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(D),
+	      POLYBENCH_ARRAY(G));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+#ifdef POLYBENCH_TIME
+  {
+    polybench_chain_plan_t plan, ref;
+    make_plan (&plan, 1, ni, nj, nk, nl, nm);
+    make_plan (&ref, 0, ni, nj, nk, nl, nm);
+    polybench_chain_report (&plan, &ref, "ABCD");
+  }
+#endif
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(ni, nl,  POLYBENCH_ARRAY(G)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(B);
+  POLYBENCH_FREE_ARRAY(C);
+  POLYBENCH_FREE_ARRAY(D);
+  POLYBENCH_FREE_ARRAY(G);
+
+  return 0;
+}
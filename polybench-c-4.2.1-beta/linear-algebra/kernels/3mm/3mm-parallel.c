@@ -0,0 +1,226 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* 3mm-parallel.c: this file is part of PolyBench/C */
+
+/* Multithreaded variant of 3mm.c: the tiles of E and F, which do not
+   depend on each other, share a first round of the work-stealing pool of
+   polybench_steal.h, and those of G a second one. Build with -fopenmp,
+   and -DPOLYBENCH_THREADS=N to set the number of threads. Every element
+   is accumulated in the order of 3mm.c. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "3mm.h"
+
+#include <polybench_steal.h>
+
+#ifndef TILE_I
+# define TILE_I 64
+#endif
+#ifndef TILE_J
+# define TILE_J 256
+#endif
+#ifndef TILE_K
+# define TILE_K 128
+#endif
+
+
+/* Array initialization. */
+static
+void init_array(int ni, int nj, int nk, int nl, int nm,
+		DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj),
+		DATA_TYPE POLYBENCH_2D(C,NJ,NM,nj,nm),
+		DATA_TYPE POLYBENCH_2D(D,NM,NL,nm,nl))
+{
+  int i, j;
+
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nk; j++)
+      A[i][j] = (DATA_TYPE) ((i*j+1) % ni) / (5*ni);
+  for (i = 0; i < nk; i++)
+    for (j = 0; j < nj; j++)
+      B[i][j] = (DATA_TYPE) ((i*(j+1)+2) % nj) / (5*nj);
+  for (i = 0; i < nj; i++)
+    for (j = 0; j < nm; j++)
+      C[i][j] = (DATA_TYPE) (i*(j+3) % nl) / (5*nl);
+  for (i = 0; i < nm; i++)
+    for (j = 0; j < nl; j++)
+      D[i][j] = (DATA_TYPE) ((i*(j+2)+2) % nk) / (5*nk);
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int ni, int nl,
+		 DATA_TYPE POLYBENCH_2D(G,NI,NL,ni,nl))
+{
+  int i, j;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("G");
+  for (i = 0; i < ni; i++)
+    for (j = 0; j < nl; j++) {
+	if ((i * ni + j) % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+	fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, G[i][j]);
+    }
+  POLYBENCH_DUMP_END("G");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* X[i0:i1][j0:j1] = beta * X (0 without scale) + alpha * Y[i0:i1][:] * Z[:][j0:j1] */
+static
+void mm_tile(int i0, int i1, int j0, int j1, int nk,
+	     DATA_TYPE alpha, DATA_TYPE beta, int scale,
+	     DATA_TYPE *X, int ldx,
+	     const DATA_TYPE *Y, int ldy,
+	     const DATA_TYPE *Z, int ldz)
+{
+  int i, j, k, kk;
+
+  for (i = i0; i < i1; i++)
+    for (j = j0; j < j1; j++)
+      X[i * ldx + j] = scale ? X[i * ldx + j] * beta : SCALAR_VAL(0.0);
+  for (kk = 0; kk < nk; kk += TILE_K)
+    for (i = i0; i < i1; i++)
+      for (k = kk; k < kk + TILE_K && k < nk; k++)
+	{
+	  DATA_TYPE y = alpha * Y[i * ldy + k];
+	  for (j = j0; j < j1; j++)
+	    X[i * ldx + j] += y * Z[k * ldz + j];
+	}
+}
+
+/* Row stride of a 2D PolyBench array, padding included. */
+#define LD(X) ((int) (&X[1][0] - &X[0][0]))
+/* Tiles of a ni x nj array. */
+#define NB_TILES(ni, nj) \
+  (((ni) + TILE_I - 1) / TILE_I * (((nj) + TILE_J - 1) / TILE_J))
+/* Tile t of X := beta * X + alpha * Y * Z, X being ni x nj. */
+#define RUN_TILE(t, ni, nj, nk, alpha, beta, scale, X, Y, Z)		\
+  do {									\
+    int tiles_j_ = ((nj) + TILE_J - 1) / TILE_J;			\
+    int i0_ = (t) / tiles_j_ * TILE_I;					\
+    int j0_ = (t) % tiles_j_ * TILE_J;					\
+    mm_tile (i0_, i0_ + TILE_I < (ni) ? i0_ + TILE_I : (ni),		\
+	     j0_, j0_ + TILE_J < (nj) ? j0_ + TILE_J : (nj),		\
+	     (nk), (alpha), (beta), (scale),				\
+	     &X[0][0], LD(X), &Y[0][0], LD(Y), &Z[0][0], LD(Z));	\
+  } while (0)
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_3mm(int ni, int nj, int nk, int nl, int nm,
+		DATA_TYPE POLYBENCH_2D(E,NI,NJ,ni,nj),
+		DATA_TYPE POLYBENCH_2D(A,NI,NK,ni,nk),
+		DATA_TYPE POLYBENCH_2D(B,NK,NJ,nk,nj),
+		DATA_TYPE POLYBENCH_2D(F,NJ,NL,nj,nl),
+		DATA_TYPE POLYBENCH_2D(C,NJ,NM,nj,nm),
+		DATA_TYPE POLYBENCH_2D(D,NM,NL,nm,nl),
+		DATA_TYPE POLYBENCH_2D(G,NI,NL,ni,nl))
+{
+  const int tiles_e = NB_TILES(_PB_NI, _PB_NJ);
+  polybench_steal_pool_t pool;
+
+  polybench_steal_init (&pool);
+
+#pragma scop
+#pragma omp parallel
+  {
+    int t;
+    /* E := A*B and F := C*D */
+#pragma omp single
+    polybench_steal_fill (&pool, tiles_e + NB_TILES(_PB_NJ, _PB_NL));
+    while (polybench_steal_next (&pool, &t))
+      if (t < tiles_e)
+	RUN_TILE (t, _PB_NI, _PB_NJ, _PB_NK, SCALAR_VAL(1.0), SCALAR_VAL(0.0), 0, E, A, B);
+      else
+	RUN_TILE (t - tiles_e, _PB_NJ, _PB_NL, _PB_NM, SCALAR_VAL(1.0), SCALAR_VAL(0.0), 0, F, C, D);
+    /* G := E*F */
+#pragma omp barrier
+#pragma omp single
+    polybench_steal_fill (&pool, NB_TILES(_PB_NI, _PB_NL));
+    while (polybench_steal_next (&pool, &t))
+      RUN_TILE (t, _PB_NI, _PB_NL, _PB_NJ, SCALAR_VAL(1.0), SCALAR_VAL(0.0), 0, G, E, F);
+  }
+#pragma endscop
+
+  polybench_steal_free (&pool);
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int ni = NI;
+  int nj = NJ;
+  int nk = NK;
+  int nl = NL;
+  int nm = NM;
+
+  /* Variable declaration/allocation. */
+  POLYBENCH_2D_ARRAY_DECL(E, DATA_TYPE, NI, NJ, ni, nj);
+  POLYBENCH_2D_ARRAY_DECL(A, DATA_TYPE, NI, NK, ni, nk);
+  POLYBENCH_2D_ARRAY_DECL(B, DATA_TYPE, NK, NJ, nk, nj);
+  POLYBENCH_2D_ARRAY_DECL(F, DATA_TYPE, NJ, NL, nj, nl);
+  POLYBENCH_2D_ARRAY_DECL(C, DATA_TYPE, NJ, NM, nj, nm);
+  POLYBENCH_2D_ARRAY_DECL(D, DATA_TYPE, NM, NL, nm, nl);
+  POLYBENCH_2D_ARRAY_DECL(G, DATA_TYPE, NI, NL, ni, nl);
+
+  /* Initialize array(s). */
+  init_array (ni, nj, nk, nl, nm,
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B),
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(D));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_3mm (ni, nj, nk, nl, nm,
+	      POLYBENCH_ARRAY(E),
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(B),
+	      POLYBENCH_ARRAY(F),
+	      POLYBENCH_ARRAY(C),
+	      POLYBENCH_ARRAY(D),
+	      POLYBENCH_ARRAY(G));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(ni, nl,  POLYBENCH_ARRAY(G)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(E);
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(B);
+  POLYBENCH_FREE_ARRAY(F);
+  POLYBENCH_FREE_ARRAY(C);
+  POLYBENCH_FREE_ARRAY(D);
+  POLYBENCH_FREE_ARRAY(G);
+
+  return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* atax-fused.c: this file is part of PolyBench/C */
+
+/* atax.c in one sweep of A: each row gives tmp[i] = A[i] x, which is
+   immediately folded into y := y + A[i]^T tmp[i]. See
+   polybench_matvec.h. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "atax.h"
+
+#include <polybench_matvec.h>
+
+
+/* Array initialization. */
+static
+void init_array (int m, int n,
+		 DATA_TYPE POLYBENCH_2D(A,M,N,m,n),
+		 DATA_TYPE POLYBENCH_1D(x,N,n))
+{
+  int i, j;
+  DATA_TYPE fn;
+  fn = (DATA_TYPE)n;
+
+  for (i = 0; i < n; i++)
+      x[i] = 1 + (i / fn);
+  for (i = 0; i < m; i++)
+    for (j = 0; j < n; j++)
+      A[i][j] = (DATA_TYPE) ((i+j) % n) / (5*m);
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int n,
+		 DATA_TYPE POLYBENCH_1D(y,N,n))
+
+{
+  int i;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("y");
+  for (i = 0; i < n; i++) {
+    if (i % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+    fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, y[i]);
+  }
+  POLYBENCH_DUMP_END("y");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_atax(int m, int n,
+		 DATA_TYPE POLYBENCH_2D(A,M,N,m,n),
+		 DATA_TYPE POLYBENCH_1D(x,N,n),
+		 DATA_TYPE POLYBENCH_1D(y,N,n),
+		 DATA_TYPE POLYBENCH_1D(tmp,M,m))
+{
+  polybench_matvec_t mv = { 0 };
+
+  mv.m = _PB_M;
+  mv.n = _PB_N;
+  mv.A = &A[0][0];
+  mv.lda = (int) (&A[1][0] - &A[0][0]);
+  mv.x = x;
+  mv.y = tmp;
+  mv.w = tmp;
+  mv.z = y;
+#pragma scop
+  polybench_matvec (&mv);
+#pragma endscop
+
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int m = M;
+  int n = N;
+
+  /* Variable declaration/allocation. */
+  POLYBENCH_2D_ARRAY_DECL(A, DATA_TYPE, M, N, m, n);
+  POLYBENCH_1D_ARRAY_DECL(x, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(y, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(tmp, DATA_TYPE, M, m);
+
+  /* Initialize array(s). */
+  init_array (m, n, POLYBENCH_ARRAY(A), POLYBENCH_ARRAY(x));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_atax (m, n,
+	       POLYBENCH_ARRAY(A),
+	       POLYBENCH_ARRAY(x),
+	       POLYBENCH_ARRAY(y),
+	       POLYBENCH_ARRAY(tmp));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+#if defined(POLYBENCH_TIME) && defined(POLYBENCH_MATVEC_REPORT)
+  /* A once, x, tmp and y */
+  polybench_matvec_report ("atax", sizeof (DATA_TYPE) * ((double) m * n + 2 * n + m),
+			   polybench_timer_get_elapsed ());
+#endif
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(n, POLYBENCH_ARRAY(y)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(x);
+  POLYBENCH_FREE_ARRAY(y);
+  POLYBENCH_FREE_ARRAY(tmp);
+
+  return 0;
+}
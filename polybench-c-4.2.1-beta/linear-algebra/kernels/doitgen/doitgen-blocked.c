@@ -0,0 +1,198 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* doitgen-blocked.c: this file is part of PolyBench/C */
+
+/* Blocked, multithreaded variant of doitgen.c. The (r, q) rows of A form
+   a NR*NQ x NP matrix multiplied in place by C4: OpenMP threads share the
+   r planes, and every plane is computed by tiles of DOITGEN_TQ rows into a
+   per-thread buffer, in DOITGEN_SB x DOITGEN_PB blocks of C4 that stay in
+   cache, then copied back over A. Build with -O3 (the tile loop is cloned
+   for AVX-512, AVX2 and the baseline ISA) and -fopenmp. Every element is
+   accumulated in the order of doitgen.c. With -DPOLYBENCH_TIME, the
+   GFLOP/s of the run are printed after the time. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "doitgen.h"
+
+#include <stdlib.h>
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+/* Rows of A per tile, and block of C4 (rows, columns). */
+#ifndef DOITGEN_TQ
+# define DOITGEN_TQ 16
+#endif
+#ifndef DOITGEN_SB
+# define DOITGEN_SB 128
+#endif
+#ifndef DOITGEN_PB
+# define DOITGEN_PB 128
+#endif
+
+
+/* Array initialization. */
+static
+void init_array(int nr, int nq, int np,
+		DATA_TYPE POLYBENCH_3D(A,NR,NQ,NP,nr,nq,np),
+		DATA_TYPE POLYBENCH_2D(C4,NP,NP,np,np))
+{
+  int i, j, k;
+
+  for (i = 0; i < nr; i++)
+    for (j = 0; j < nq; j++)
+      for (k = 0; k < np; k++)
+	A[i][j][k] = (DATA_TYPE) ((i*j + k)%np) / np;
+  for (i = 0; i < np; i++)
+    for (j = 0; j < np; j++)
+      C4[i][j] = (DATA_TYPE) (i*j % np) / np;
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int nr, int nq, int np,
+		 DATA_TYPE POLYBENCH_3D(A,NR,NQ,NP,nr,nq,np))
+{
+  int i, j, k;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("A");
+  for (i = 0; i < nr; i++)
+    for (j = 0; j < nq; j++)
+      for (k = 0; k < np; k++) {
+	if ((i*nq*np+j*np+k) % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+	fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, A[i][j][k]);
+      }
+  POLYBENCH_DUMP_END("A");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* T[0:q1-q0][0:np] := A[r][q0:q1][:] * C4, row q of A being ldq elements
+   after row q-1. */
+static POLYBENCH_ISA_CLONES
+void doitgen_tile(int q0, int q1, int np,
+		  const DATA_TYPE* POLYBENCH_RESTRICT A, int ldq,
+		  const DATA_TYPE* POLYBENCH_RESTRICT C4, int ldc,
+		  DATA_TYPE* POLYBENCH_RESTRICT T)
+{
+  int q, p, s, ss, pp;
+
+  for (q = q0; q < q1; q++)
+    for (p = 0; p < np; p++)
+      T[(q - q0) * np + p] = SCALAR_VAL(0.0);
+  for (pp = 0; pp < np; pp += DOITGEN_PB)
+    {
+      int pe = pp + DOITGEN_PB < np ? pp + DOITGEN_PB : np;
+      for (ss = 0; ss < np; ss += DOITGEN_SB)
+	for (q = q0; q < q1; q++)
+	  {
+	    DATA_TYPE* t = T + (q - q0) * np;
+	    for (s = ss; s < ss + DOITGEN_SB && s < np; s++)
+	      {
+		DATA_TYPE a = A[q * ldq + s];
+		for (p = pp; p < pe; p++)
+		  t[p] += a * C4[s * ldc + p];
+	      }
+	  }
+    }
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+void kernel_doitgen(int nr, int nq, int np,
+		    DATA_TYPE POLYBENCH_3D(A,NR,NQ,NP,nr,nq,np),
+		    DATA_TYPE POLYBENCH_2D(C4,NP,NP,np,np))
+{
+  /* Row strides, padding included. */
+  const int ldq = (int) (&A[0][1][0] - &A[0][0][0]);
+  const int ldc = (int) (&C4[1][0] - &C4[0][0]);
+
+#if defined(_OPENMP) && defined(POLYBENCH_THREADS)
+  omp_set_num_threads (POLYBENCH_THREADS);
+#endif
+
+#pragma scop
+#pragma omp parallel
+  {
+    int r, q, q0, p;
+    /* the rows of a tile, until they are written back */
+    DATA_TYPE* T = (DATA_TYPE*) polybench_alloc_data (DOITGEN_TQ * _PB_NP,
+						      sizeof (DATA_TYPE));
+#pragma omp for schedule(static)
+    for (r = 0; r < _PB_NR; r++)
+      for (q0 = 0; q0 < _PB_NQ; q0 += DOITGEN_TQ)
+	{
+	  int q1 = q0 + DOITGEN_TQ < _PB_NQ ? q0 + DOITGEN_TQ : _PB_NQ;
+	  doitgen_tile (q0, q1, _PB_NP, &A[r][0][0], ldq, &C4[0][0], ldc, T);
+	  for (q = q0; q < q1; q++)
+	    for (p = 0; p < _PB_NP; p++)
+	      A[r][q][p] = T[(q - q0) * _PB_NP + p];
+	}
+    polybench_free_data (T);
+  }
+#pragma endscop
+
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int nr = NR;
+  int nq = NQ;
+  int np = NP;
+
+  /* Variable declaration/allocation. */
+  POLYBENCH_3D_ARRAY_DECL(A,DATA_TYPE,NR,NQ,NP,nr,nq,np);
+  POLYBENCH_2D_ARRAY_DECL(C4,DATA_TYPE,NP,NP,np,np);
+
+  /* Initialize array(s). */
+  init_array (nr, nq, np,
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(C4));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_doitgen (nr, nq, np,
+		  POLYBENCH_ARRAY(A),
+		  POLYBENCH_ARRAY(C4));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+#ifdef POLYBENCH_TIME
+  printf ("doitgen flops=%.0f GFLOP/s=%.2f\n", 2.0 * nr * nq * np * np,
+	  2.0 * nr * nq * np * np / polybench_timer_get_elapsed () * 1e-9);
+#endif
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(nr, nq, np,  POLYBENCH_ARRAY(A)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(C4);
+
+  return 0;
+}
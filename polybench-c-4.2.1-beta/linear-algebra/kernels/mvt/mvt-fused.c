@@ -0,0 +1,176 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* mvt-fused.c: this file is part of PolyBench/C */
+
+/* mvt.c in one sweep of A: A y_1 and A^T y_2 are read off the same
+   rows, instead of a row-wise then a column-wise pass. See
+   polybench_matvec.h. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "mvt.h"
+
+#include <polybench_matvec.h>
+
+
+/* Array initialization. */
+static
+void init_array(int n,
+		DATA_TYPE POLYBENCH_1D(x1,N,n),
+		DATA_TYPE POLYBENCH_1D(x2,N,n),
+		DATA_TYPE POLYBENCH_1D(y_1,N,n),
+		DATA_TYPE POLYBENCH_1D(y_2,N,n),
+		DATA_TYPE POLYBENCH_2D(A,N,N,n,n))
+{
+  int i, j;
+
+  for (i = 0; i < n; i++)
+    {
+      x1[i] = (DATA_TYPE) (i % n) / n;
+      x2[i] = (DATA_TYPE) ((i + 1) % n) / n;
+      y_1[i] = (DATA_TYPE) ((i + 3) % n) / n;
+      y_2[i] = (DATA_TYPE) ((i + 4) % n) / n;
+      for (j = 0; j < n; j++)
+	A[i][j] = (DATA_TYPE) (i*j % n) / n;
+    }
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int n,
+		 DATA_TYPE POLYBENCH_1D(x1,N,n),
+		 DATA_TYPE POLYBENCH_1D(x2,N,n))
+
+{
+  int i;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("x1");
+  for (i = 0; i < n; i++) {
+    if (i % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+    fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, x1[i]);
+  }
+  POLYBENCH_DUMP_END("x1");
+
+  POLYBENCH_DUMP_BEGIN("x2");
+  for (i = 0; i < n; i++) {
+    if (i % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+    fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, x2[i]);
+  }
+  POLYBENCH_DUMP_END("x2");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_mvt(int n,
+		DATA_TYPE POLYBENCH_1D(x1,N,n),
+		DATA_TYPE POLYBENCH_1D(x2,N,n),
+		DATA_TYPE POLYBENCH_1D(y_1,N,n),
+		DATA_TYPE POLYBENCH_1D(y_2,N,n),
+		DATA_TYPE POLYBENCH_2D(A,N,N,n,n),
+		DATA_TYPE POLYBENCH_1D(t1,N,n),
+		DATA_TYPE POLYBENCH_1D(t2,N,n))
+{
+  int i;
+  polybench_matvec_t mv = { 0 };
+
+  mv.m = _PB_N;
+  mv.n = _PB_N;
+  mv.A = &A[0][0];
+  mv.lda = (int) (&A[1][0] - &A[0][0]);
+  mv.x = y_1;
+  mv.y = t1;
+  mv.w = y_2;
+  mv.z = t2;
+#pragma scop
+  polybench_matvec (&mv);
+  for (i = 0; i < _PB_N; i++)
+    {
+      x1[i] = x1[i] + t1[i];
+      x2[i] = x2[i] + t2[i];
+    }
+#pragma endscop
+
+}
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int n = N;
+
+  /* Variable declaration/allocation. */
+  POLYBENCH_2D_ARRAY_DECL(A, DATA_TYPE, N, N, n, n);
+  POLYBENCH_1D_ARRAY_DECL(x1, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(x2, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(y_1, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(y_2, DATA_TYPE, N, n);
+  /* A y_1 and A^T y_2. */
+  POLYBENCH_1D_ARRAY_DECL(t1, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(t2, DATA_TYPE, N, n);
+
+
+  /* Initialize array(s). */
+  init_array (n,
+	      POLYBENCH_ARRAY(x1),
+	      POLYBENCH_ARRAY(x2),
+	      POLYBENCH_ARRAY(y_1),
+	      POLYBENCH_ARRAY(y_2),
+	      POLYBENCH_ARRAY(A));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_mvt (n,
+	      POLYBENCH_ARRAY(x1),
+	      POLYBENCH_ARRAY(x2),
+	      POLYBENCH_ARRAY(y_1),
+	      POLYBENCH_ARRAY(y_2),
+	      POLYBENCH_ARRAY(A),
+	      POLYBENCH_ARRAY(t1),
+	      POLYBENCH_ARRAY(t2));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+#if defined(POLYBENCH_TIME) && defined(POLYBENCH_MATVEC_REPORT)
+  /* A once, x1 and x2 read and written, y_1 and y_2 */
+  polybench_matvec_report ("mvt", sizeof (DATA_TYPE) * ((double) n * n + 6 * n),
+			   polybench_timer_get_elapsed ());
+#endif
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(n, POLYBENCH_ARRAY(x1), POLYBENCH_ARRAY(x2)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(A);
+  POLYBENCH_FREE_ARRAY(x1);
+  POLYBENCH_FREE_ARRAY(x2);
+  POLYBENCH_FREE_ARRAY(y_1);
+  POLYBENCH_FREE_ARRAY(y_2);
+  POLYBENCH_FREE_ARRAY(t1);
+  POLYBENCH_FREE_ARRAY(t2);
+
+  return 0;
+}
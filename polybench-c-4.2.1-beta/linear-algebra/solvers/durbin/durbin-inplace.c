@@ -0,0 +1,252 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/* durbin-inplace.c: this file is part of PolyBench/C */
+
+/* Variant of durbin.c updating y in place: y[i] and y[k-1-i] are updated
+   together from their old values, so the z buffer and its copy back to y
+   are gone, and the dot product of the next iteration is accumulated on
+   the same pass, the new y[i] and y[k-1-i] being multiplied by r[k-i] and
+   r[i+1]. The pass is vectorized with one accumulator per half of y, and
+   cloned for AVX-512, AVX2 and the baseline ISA. Build with -O3 and
+   -fopenmp-simd (or -fopenmp) for the simd reductions. With
+   -DPOLYBENCH_DURBIN_COMPARE, the loops of durbin.c and this kernel are
+   then timed again on the same input for comparison (durbin
+   reference_s=). Double results match durbin.c exactly; float ones
+   depend on the summation order, by up to 1.6 at MEDIUM where the
+   float recursion is ill-conditioned. */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/* Include polybench common header. */
+#include <polybench.h>
+
+/* Include benchmark-specific header. */
+#include "durbin.h"
+
+
+/* Array initialization. */
+static
+void init_array (int n,
+		 DATA_TYPE POLYBENCH_1D(r,N,n))
+{
+  int i, j;
+
+  for (i = 0; i < n; i++)
+    {
+      r[i] = (n+1-i);
+    }
+}
+
+
+/* DCE code. Must scan the entire live-out data.
+   Can be used also to check the correctness of the output. */
+static
+void print_array(int n,
+		 DATA_TYPE POLYBENCH_1D(y,N,n))
+
+{
+  int i;
+
+  POLYBENCH_DUMP_START;
+  POLYBENCH_DUMP_BEGIN("y");
+  for (i = 0; i < n; i++) {
+    if (i % 20 == 0) fprintf (POLYBENCH_DUMP_TARGET, "\n");
+    fprintf (POLYBENCH_DUMP_TARGET, DATA_PRINTF_MODIFIER, y[i]);
+  }
+  POLYBENCH_DUMP_END("y");
+  POLYBENCH_DUMP_FINISH;
+}
+
+
+/* y[0:k] := y[0:k] + alpha * y[k-1:0] in place, y[k] := alpha, and
+   returns the dot product of r[k:0] and the new y[0:k+1], needed by
+   iteration k+1. */
+static POLYBENCH_ISA_CLONES
+DATA_TYPE durbin_update(int k, DATA_TYPE alpha,
+			DATA_TYPE* POLYBENCH_RESTRICT y,
+			const DATA_TYPE* POLYBENCH_RESTRICT r)
+{
+  /* pairs (i, k-1-i), then the middle element when k is odd */
+  DATA_TYPE* POLYBENCH_RESTRICT lo = y;
+  DATA_TYPE* POLYBENCH_RESTRICT hi = y + k - 1;
+  const DATA_TYPE* rlo = r + k;
+  const DATA_TYPE* rhi = r + 1;
+  const int h = k / 2;
+  DATA_TYPE s0 = SCALAR_VAL(0.0);
+  DATA_TYPE s1 = SCALAR_VAL(0.0);
+  int i;
+
+#pragma omp simd reduction(+:s0,s1)
+  for (i = 0; i < h; i++)
+    {
+      DATA_TYPE a = lo[i];
+      DATA_TYPE b = hi[-i];
+      DATA_TYPE ya = a + alpha * b;
+      DATA_TYPE yb = b + alpha * a;
+      lo[i] = ya;
+      hi[-i] = yb;
+      s0 += rlo[-i] * ya;
+      s1 += rhi[i] * yb;
+    }
+  if (k % 2)
+    {
+      y[h] = y[h] + alpha * y[h];
+      s0 += r[k - h] * y[h];
+    }
+  y[k] = alpha;
+  return s0 + s1 + r[0] * alpha;
+}
+
+
+/* Main computational kernel. The whole function will be timed,
+   including the call and return. */
+static
+void kernel_durbin(int n,
+		   DATA_TYPE POLYBENCH_1D(r,N,n),
+		   DATA_TYPE POLYBENCH_1D(y,N,n))
+{
+ DATA_TYPE alpha;
+ DATA_TYPE beta;
+ DATA_TYPE sum;
+
+ int k;
+
+#pragma scop
+ y[0] = -r[0];
+ beta = SCALAR_VAL(1.0);
+ alpha = -r[0];
+ sum = r[0]*y[0];
+
+ for (k = 1; k < _PB_N; k++) {
+   beta = (1-alpha*alpha)*beta;
+   alpha = - (r[k] + sum)/beta;
+   sum = durbin_update(k, alpha, y, r);
+ }
+#pragma endscop
+
+}
+
+
+#ifdef POLYBENCH_DURBIN_COMPARE
+/* Separate from the timer of polybench.c, whose last measure is the one
+   of the kernel. */
+static
+double durbin_clock (void)
+{
+  struct timespec ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+/* Loops of durbin.c. */
+static
+void reference_durbin(int n,
+		      DATA_TYPE POLYBENCH_1D(r,N,n),
+		      DATA_TYPE POLYBENCH_1D(y,N,n))
+{
+ DATA_TYPE z[N];
+ DATA_TYPE alpha;
+ DATA_TYPE beta;
+ DATA_TYPE sum;
+
+ int i,k;
+
+ y[0] = -r[0];
+ beta = SCALAR_VAL(1.0);
+ alpha = -r[0];
+
+ for (k = 1; k < _PB_N; k++) {
+   beta = (1-alpha*alpha)*beta;
+   sum = SCALAR_VAL(0.0);
+   for (i=0; i<k; i++) {
+      sum += r[k-i-1]*y[i];
+   }
+   alpha = - (r[k] + sum)/beta;
+
+   for (i=0; i<k; i++) {
+      z[i] = y[i] + alpha*y[k-i-1];
+   }
+   for (i=0; i<k; i++) {
+     y[i] = z[i];
+   }
+   y[k] = alpha;
+ }
+}
+#endif
+
+
+int main(int argc, char** argv)
+{
+  /* Retrieve problem size. */
+  int n = N;
+
+  /* Variable declaration/allocation. */
+  POLYBENCH_1D_ARRAY_DECL(r, DATA_TYPE, N, n);
+  POLYBENCH_1D_ARRAY_DECL(y, DATA_TYPE, N, n);
+#ifdef POLYBENCH_DURBIN_COMPARE
+  /* output of the timed comparison */
+  POLYBENCH_1D_ARRAY_DECL(z, DATA_TYPE, N, n);
+#endif
+
+
+  /* Initialize array(s). */
+  init_array (n, POLYBENCH_ARRAY(r));
+
+  /* Start timer. */
+  polybench_start_instruments;
+
+  /* Run kernel. */
+  kernel_durbin (n,
+		 POLYBENCH_ARRAY(r),
+		 POLYBENCH_ARRAY(y));
+
+  /* Stop and print timer. */
+  polybench_stop_instruments;
+  polybench_print_instruments;
+#ifdef POLYBENCH_DURBIN_COMPARE
+  {
+    /* best of 3 runs of each kernel */
+    double t, t_ref = 0, t_inplace = 0;
+    int run;
+    for (run = 0; run < 3; run++)
+      {
+	t = durbin_clock ();
+	reference_durbin (n, POLYBENCH_ARRAY(r), POLYBENCH_ARRAY(z));
+	t = durbin_clock () - t;
+	t_ref = run == 0 || t < t_ref ? t : t_ref;
+	t = durbin_clock ();
+	kernel_durbin (n, POLYBENCH_ARRAY(r), POLYBENCH_ARRAY(z));
+	t = durbin_clock () - t;
+	t_inplace = run == 0 || t < t_inplace ? t : t_inplace;
+      }
+    printf ("durbin n=%d reference_s=%.3g inplace_s=%.3g speedup=%.2f\n",
+	    n, t_ref, t_inplace, t_inplace > 0 ? t_ref / t_inplace : 0);
+  }
+#endif
+
+  /* Prevent dead-code elimination. All live-out data must be printed
+     by the function call in argument. */
+  polybench_prevent_dce(print_array(n, POLYBENCH_ARRAY(y)));
+
+  /* Be clean. */
+  POLYBENCH_FREE_ARRAY(r);
+  POLYBENCH_FREE_ARRAY(y);
+#ifdef POLYBENCH_DURBIN_COMPARE
+  POLYBENCH_FREE_ARRAY(z);
+#endif
+
+  return 0;
+}
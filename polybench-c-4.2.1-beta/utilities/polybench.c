@@ -17,12 +17,52 @@
 #include <time.h>
 #include <sys/time.h>
 #include <sys/resource.h>
+#include <sys/mman.h>
 #include <sched.h>
 #include <math.h>
 #ifdef _OPENMP
 # include <omp.h>
 #endif
 
+/* NUMA placement of the data allocated with polybench_alloc_data. By
+   default pages land on the node of the thread that first touches
+   them, usually the one running the sequential init_array. */
+#define POLYBENCH_NUMA_DEFAULT      0
+#define POLYBENCH_NUMA_LOCAL        1 /* node of the allocating thread */
+#define POLYBENCH_NUMA_INTERLEAVE   2 /* round-robin on nodes with memory */
+#define POLYBENCH_NUMA_BIND         3 /* node POLYBENCH_NUMA_NODE only */
+#define POLYBENCH_NUMA_FIRST_TOUCH  4 /* faulted in by a parallel loop */
+#ifndef POLYBENCH_NUMA_POLICY
+# define POLYBENCH_NUMA_POLICY POLYBENCH_NUMA_DEFAULT
+#endif
+#ifndef POLYBENCH_NUMA_NODE
+# define POLYBENCH_NUMA_NODE 0
+#endif
+#if POLYBENCH_NUMA_NODE < 0 || POLYBENCH_NUMA_NODE >= 64
+# error "POLYBENCH_NUMA_NODE must fit in a 64-bit node mask"
+#endif
+/* Huge pages for the data allocated with polybench_alloc_data. The
+   explicit hugetlb sizes need pages reserved by the administrator
+   (vm.nr_hugepages), and fall back to transparent huge pages. */
+#define POLYBENCH_HUGEPAGES_NONE    0
+#define POLYBENCH_HUGEPAGES_THP     1 /* 2MB aligned, madvise(MADV_HUGEPAGE) */
+#define POLYBENCH_HUGEPAGES_2MB     2 /* MAP_HUGETLB, 2MB pages */
+#define POLYBENCH_HUGEPAGES_1GB     3 /* MAP_HUGETLB, 1GB pages */
+#ifndef POLYBENCH_HUGEPAGES
+# define POLYBENCH_HUGEPAGES POLYBENCH_HUGEPAGES_NONE
+#endif
+#if POLYBENCH_HUGEPAGES != POLYBENCH_HUGEPAGES_NONE
+# ifndef MAP_HUGE_SHIFT
+#  define MAP_HUGE_SHIFT 26
+# endif
+#endif
+
+#if POLYBENCH_NUMA_POLICY != POLYBENCH_NUMA_DEFAULT && \
+    POLYBENCH_NUMA_POLICY != POLYBENCH_NUMA_FIRST_TOUCH
+# include <sys/syscall.h>
+# include <linux/mempolicy.h>
+#endif
+
 #if defined(POLYBENCH_PAPI)
 # undef POLYBENCH_PAPI
 # include "polybench.h"
@@ -59,20 +99,47 @@ double polybench_program_total_flops = 0;
 #endif
 
 /*
- * Allocation table, to enable inter-array padding. All data allocated
- * with polybench_alloc_data should be freed with polybench_free_data.
+ * Every block returned by polybench_alloc_data is tagged with a
+ * descriptor stored right below the user pointer, so that
+ * polybench_free_data recovers the original allocation in O(1),
+ * whatever the inter-array padding or the backing memory.
  *
  */
-#define NB_INITIAL_TABLE_ENTRIES 512
-struct polybench_data_ptrs
+#define POLYBENCH_BLOCK_MAGIC 0x9017BE4CU
+#define POLYBENCH_BLOCK_MALLOC 0
+#define POLYBENCH_BLOCK_MAPPED 1
+#define POLYBENCH_BLOCK_ARENA 2
+/* User data starts one page after the allocation: the descriptor lives
+   there, and the data keeps its page alignment (that of the huge pages
+   in use, see hugepage_map). */
+#define POLYBENCH_DATA_OFFSET 4096
+struct polybench_block
 {
-  void** user_view;
-  void** real_ptr;
-  int nb_entries;
-  int nb_avail_entries;
+  void* base;         /* start of the allocation */
+  size_t len;         /* length of the allocation */
+  size_t user_sz;     /* bytes requested by the user */
+  unsigned int kind;  /* POLYBENCH_BLOCK_* */
+  unsigned int magic;
 };
-static struct polybench_data_ptrs* _polybench_alloc_table = NULL;
 static size_t polybench_inter_array_padding_sz = 0;
+/* Explicit inter-array padding: the i-th array allocated since no
+   array was live is moved forward by the i-th offset (in bytes) of
+   this comma separated list, the last one being reused afterwards. */
+#ifdef POLYBENCH_INTER_ARRAY_PADDING_OFFSETS
+static const size_t polybench_inter_array_offsets[] =
+  { POLYBENCH_INTER_ARRAY_PADDING_OFFSETS };
+#endif
+static unsigned int polybench_inter_array_index = 0;
+static struct polybench_alloc_stats polybench_alloc_stats_data;
+
+/* Arena owned by the caller (see polybench_set_arena): blocks are
+   carved out of it and never released individually. */
+static char* polybench_arena_base = NULL;
+static size_t polybench_arena_size = 0;
+static size_t polybench_arena_used = 0;
+
+/* Stream of the array dumps, stderr when NULL. */
+FILE* polybench_dump_target = NULL;
 
 /* Timer code (gettimeofday). */
 double polybench_t_start, polybench_t_end;
@@ -406,139 +473,307 @@ void polybench_timer_print()
 #endif
 }
 
-/*
- * These functions are used only if the user defines a specific
- * inter-array padding. It grows a global structure,
- * _polybench_alloc_table, which keeps track of the data allocated via
- * polybench_alloc_data (on which inter-array padding is applied), so
- * that the original, non-shifted pointer can be recovered when
- * calling polybench_free_data.
- *
- */
-#ifdef POLYBENCH_ENABLE_INTARRAY_PAD
+/* Length of the last timed region, in seconds (cycles with
+   POLYBENCH_CYCLE_ACCURATE_TIMER). Lets a harness that loads this file
+   as a shared object collect the measure without parsing stdout. */
+double polybench_timer_get_elapsed()
+{
+#ifndef POLYBENCH_CYCLE_ACCURATE_TIMER
+  return polybench_t_end - polybench_t_start;
+#else
+  return (double) (polybench_c_end - polybench_c_start);
+#endif
+}
+
+#if POLYBENCH_NUMA_POLICY == POLYBENCH_NUMA_INTERLEAVE
+/* Bit mask of the nodes with memory, from the sysfs list ("0-1,3").
+   Node 0 alone if it cannot be read. */
 static
-void grow_alloc_table()
+unsigned long numa_nodes_with_memory()
 {
-  if (_polybench_alloc_table == NULL ||
-      (_polybench_alloc_table->nb_entries % NB_INITIAL_TABLE_ENTRIES) != 0 ||
-      _polybench_alloc_table->nb_avail_entries != 0)
+  unsigned long mask = 0;
+  int first, last;
+  char sep;
+  FILE* f = fopen ("/sys/devices/system/node/has_memory", "r");
+  if (f == NULL)
+    return 1UL;
+  while (fscanf (f, "%d", &first) == 1)
     {
-      /* Should never happen if the API is properly used. */
-      fprintf (stderr, "[ERROR] Inter-array padding requires to use polybench_alloc_data and polybench_free_data\n");
-      exit (1);
+      last = first;
+      sep = 0;
+      if (fscanf (f, "%c", &sep) == 1 && sep == '-')
+	{
+	  if (fscanf (f, "%d", &last) != 1)
+	    break;
+	  sep = 0;
+	  if (fscanf (f, "%c", &sep) != 1)
+	    sep = 0;
+	}
+      for (; first <= last && first < (int) (8 * sizeof(mask)); ++first)
+	mask |= 1UL << first;
+      if (sep != ',')
+	break;
     }
-  size_t sz = _polybench_alloc_table->nb_entries;
-  sz += NB_INITIAL_TABLE_ENTRIES;
-  _polybench_alloc_table->user_view =
-    realloc (_polybench_alloc_table->user_view, sz * sizeof(void*));
-  assert(_polybench_alloc_table->user_view != NULL);
-  _polybench_alloc_table->real_ptr =
-    realloc (_polybench_alloc_table->real_ptr, sz * sizeof(void*));
-  assert(_polybench_alloc_table->real_ptr != NULL);
-  _polybench_alloc_table->nb_avail_entries = NB_INITIAL_TABLE_ENTRIES;
+  fclose (f);
+  return mask ? mask : 1UL;
 }
+#endif
+
 
+#if POLYBENCH_NUMA_POLICY != POLYBENCH_NUMA_DEFAULT
+/* Apply the NUMA policy to a fresh allocation, before any of its
+   pages is touched. ptr must be page-aligned and own every page up to
+   ptr + sz rounded up to a page: the policy covers them all. */
 static
-void* register_padded_pointer(void* ptr, size_t orig_sz, size_t padded_sz)
+void numa_place(void* ptr, size_t sz)
 {
-  if (_polybench_alloc_table == NULL)
+  size_t page_sz = (size_t) sysconf (_SC_PAGESIZE);
+  size_t len = (sz + page_sz - 1) / page_sz * page_sz;
+  assert ((size_t) ptr % page_sz == 0);
+# if POLYBENCH_NUMA_POLICY == POLYBENCH_NUMA_FIRST_TOUCH
+  /* Fault pages in with the static schedule of a parallel init, so
+     that each page lands on the node of the thread that will use it.
+     Without OpenMP this is the default sequential first touch. */
+  long p;
+  long nb_pages = (long) (len / page_sz);
+#  ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#  endif
+  for (p = 0; p < nb_pages; p++)
+    ((char*) ptr)[p * page_sz] = 0;
+# else
+  static int warned = 0;
+  unsigned long nodemask = 0;
+  int mode;
+#  if POLYBENCH_NUMA_POLICY == POLYBENCH_NUMA_LOCAL
+  /* Preferred with an empty mask means local allocation. */
+  mode = MPOL_PREFERRED;
+#  elif POLYBENCH_NUMA_POLICY == POLYBENCH_NUMA_INTERLEAVE
+  mode = MPOL_INTERLEAVE;
+  nodemask = numa_nodes_with_memory ();
+#  elif POLYBENCH_NUMA_POLICY == POLYBENCH_NUMA_BIND
+  mode = MPOL_BIND;
+  nodemask = 1UL << POLYBENCH_NUMA_NODE;
+#  else
+#   error "Unknown POLYBENCH_NUMA_POLICY"
+#  endif
+  if (syscall (SYS_mbind, ptr, len, mode, nodemask ? &nodemask : NULL,
+	       nodemask ? 8 * sizeof(nodemask) + 1 : 0, 0) != 0 && ! warned)
     {
-      fprintf (stderr, "[ERROR] Inter-array padding requires to use polybench_alloc_data and polybench_free_data\n");
-      exit (1);
+      warned = 1;
+      fprintf (stderr, "[PolyBench] mbind: NUMA policy %d not applied\n",
+	       POLYBENCH_NUMA_POLICY);
+    }
+# endif
+}
+#endif
+
+
+#if POLYBENCH_HUGEPAGES != POLYBENCH_HUGEPAGES_NONE
+/* Huge page allocations are private anonymous mappings, laid out so
+   that the user data, POLYBENCH_DATA_OFFSET bytes in, starts on a huge
+   page: the descriptor gets the regular page right below it. */
+#define HUGEPAGE_2MB (2UL << 20)
+#define HUGEPAGE_1GB (1UL << 30)
+
+static
+size_t round_up(size_t sz, size_t align)
+{
+  return (sz + align - 1) / align * align;
+}
+
+/* Maps data_sz bytes starting on a boundary of page, with hugetlb pages
+   of 1 << shift bytes (regular pages with shift 0), and the regular page
+   of the descriptor below them. Returns the start of the latter. */
+static
+void* hugepage_map_aligned(size_t data_sz, size_t page, int shift, size_t* len)
+{
+  size_t data_len = round_up (data_sz, page);
+  /* Over-allocate, then trim the mapping to the descriptor page and
+     the aligned data. */
+  size_t map_len = data_len + page;
+  char* raw;
+  char* data;
+  raw = (char*) mmap (NULL, map_len, PROT_READ | PROT_WRITE,
+		      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED)
+    return NULL;
+  data = (char*) round_up ((size_t) raw + POLYBENCH_DATA_OFFSET, page);
+  if (shift != 0 &&
+      mmap (data, data_len, PROT_READ | PROT_WRITE,
+	    MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB |
+	    (shift << MAP_HUGE_SHIFT), -1, 0) == MAP_FAILED)
+    {
+      munmap (raw, map_len);
+      return NULL;
     }
-  if (_polybench_alloc_table->nb_avail_entries == 0)
-    grow_alloc_table ();
-  int id = _polybench_alloc_table->nb_entries++;
-  _polybench_alloc_table->real_ptr[id] = ptr;
-  _polybench_alloc_table->user_view[id] = ptr + (padded_sz - orig_sz);
+  if (data - POLYBENCH_DATA_OFFSET != raw)
+    munmap (raw, (data - POLYBENCH_DATA_OFFSET) - raw);
+  if (data + data_len != raw + map_len)
+    munmap (data + data_len, (raw + map_len) - (data + data_len));
+  *len = POLYBENCH_DATA_OFFSET + data_len;
+  return data - POLYBENCH_DATA_OFFSET;
+}
 
-  return _polybench_alloc_table->user_view[id];
+static
+void* hugepage_map(size_t sz, size_t* len)
+{
+  static int warned = 0;
+  size_t data_sz = sz - POLYBENCH_DATA_OFFSET;
+  void* base = NULL;
+# if POLYBENCH_HUGEPAGES == POLYBENCH_HUGEPAGES_1GB
+  /* A 1GB page would mostly be wasted on a smaller array. */
+  if (data_sz >= HUGEPAGE_1GB / 2)
+    base = hugepage_map_aligned (data_sz, HUGEPAGE_1GB, 30, len);
+# endif
+# if POLYBENCH_HUGEPAGES >= POLYBENCH_HUGEPAGES_2MB
+  if (base == NULL)
+    base = hugepage_map_aligned (data_sz, HUGEPAGE_2MB, 21, len);
+  if (base == NULL && ! warned)
+    {
+      warned = 1;
+      fprintf (stderr, "[PolyBench] MAP_HUGETLB: no huge page available, using transparent huge pages\n");
+    }
+# endif
+  if (base == NULL)
+    {
+      /* Transparent huge pages only back 2MB aligned ranges. */
+      base = hugepage_map_aligned (data_sz, HUGEPAGE_2MB, 0, len);
+      if (base == NULL)
+	return NULL;
+      if (madvise ((char*) base + POLYBENCH_DATA_OFFSET,
+		   *len - POLYBENCH_DATA_OFFSET, MADV_HUGEPAGE) != 0 && ! warned)
+	{
+	  warned = 1;
+	  fprintf (stderr, "[PolyBench] madvise: transparent huge pages not available\n");
+	}
+    }
+  return base;
 }
+#endif
 
 
 static
-void
-free_data_from_alloc_table (void* ptr)
+void* arena_alloc(size_t sz, size_t* len)
 {
-  if (_polybench_alloc_table != NULL && _polybench_alloc_table->nb_entries > 0)
+  static int warned = 0;
+  /* Blocks start on a page boundary, as with posix_memalign. */
+  size_t rounded = (sz + 4095) / 4096 * 4096;
+  size_t offset = __atomic_fetch_add (&polybench_arena_used, rounded,
+				      __ATOMIC_RELAXED);
+  if (offset + rounded > polybench_arena_size)
     {
-      int i;
-      for (i = 0; i < _polybench_alloc_table->nb_entries; ++i)
-	if (_polybench_alloc_table->user_view[i] == ptr ||
-	    _polybench_alloc_table->real_ptr[i] == ptr)
-	  break;
-      if (i != _polybench_alloc_table->nb_entries)
+      if (! warned)
 	{
-	  free (_polybench_alloc_table->real_ptr[i]);
-	  for (; i < _polybench_alloc_table->nb_entries - 1; ++i)
-	    {
-	      _polybench_alloc_table->user_view[i] =
-		_polybench_alloc_table->user_view[i + 1];
-	      _polybench_alloc_table->real_ptr[i] =
-		_polybench_alloc_table->real_ptr[i + 1];
-	    }
-	  _polybench_alloc_table->nb_entries--;
-	  _polybench_alloc_table->nb_avail_entries++;
-	  if (_polybench_alloc_table->nb_entries == 0)
-	    {
-	      free (_polybench_alloc_table->user_view);
-	      free (_polybench_alloc_table->real_ptr);
-	      free (_polybench_alloc_table);
-	      _polybench_alloc_table = NULL;
-	    }
+	  warned = 1;
+	  fprintf (stderr, "[PolyBench] arena exhausted, using the system allocator\n");
 	}
+      return NULL;
     }
+  *len = rounded;
+  return polybench_arena_base + offset;
 }
 
+
 static
-void check_alloc_table_state()
+void* block_alloc(size_t sz, size_t* len, unsigned int* kind)
 {
-  if (_polybench_alloc_table == NULL)
+  if (polybench_arena_base != NULL)
     {
-      _polybench_alloc_table = (struct polybench_data_ptrs*)
-	malloc (sizeof(struct polybench_data_ptrs));
-      assert(_polybench_alloc_table != NULL);
-      _polybench_alloc_table->user_view =
-	(void**) malloc (sizeof(void*) * NB_INITIAL_TABLE_ENTRIES);
-      assert(_polybench_alloc_table->user_view != NULL);
-      _polybench_alloc_table->real_ptr =
-	(void**) malloc (sizeof(void*) * NB_INITIAL_TABLE_ENTRIES);
-      assert(_polybench_alloc_table->real_ptr != NULL);
-      _polybench_alloc_table->nb_entries = 0;
-      _polybench_alloc_table->nb_avail_entries = NB_INITIAL_TABLE_ENTRIES;
+      void* base = arena_alloc (sz, len);
+      if (base != NULL)
+	{
+	  *kind = POLYBENCH_BLOCK_ARENA;
+	  return base;
+	}
     }
+#if POLYBENCH_HUGEPAGES != POLYBENCH_HUGEPAGES_NONE
+  *kind = POLYBENCH_BLOCK_MAPPED;
+  return hugepage_map (sz, len);
+#else
+  void* base = NULL;
+  *kind = POLYBENCH_BLOCK_MALLOC;
+  *len = sz;
+  if (posix_memalign (&base, 4096, sz) != 0)
+    return NULL;
+  return base;
+#endif
 }
 
-#endif // !POLYBENCH_ENABLE_INTARRAY_PAD
+
+/* Statistics are updated atomically: versions may allocate from
+   several threads. */
+static
+void account_alloc(size_t sz)
+{
+  struct polybench_alloc_stats* st = &polybench_alloc_stats_data;
+  unsigned long long live =
+    __atomic_add_fetch (&st->live_bytes, sz, __ATOMIC_RELAXED);
+  unsigned long long peak = __atomic_load_n (&st->peak_bytes, __ATOMIC_RELAXED);
+  while (live > peak &&
+	 ! __atomic_compare_exchange_n (&st->peak_bytes, &peak, live, 1,
+					__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    ;
+  __atomic_add_fetch (&st->total_bytes, sz, __ATOMIC_RELAXED);
+  __atomic_add_fetch (&st->nb_allocs, 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch (&st->nb_live, 1, __ATOMIC_RELAXED);
+}
+
+
+static
+void account_free(size_t sz)
+{
+  struct polybench_alloc_stats* st = &polybench_alloc_stats_data;
+  __atomic_sub_fetch (&st->live_bytes, sz, __ATOMIC_RELAXED);
+  /* Every array is gone: the next run of the kernel gets the same
+     inter-array padding as this one. */
+  if (__atomic_sub_fetch (&st->nb_live, 1, __ATOMIC_RELAXED) == 0)
+    {
+      __atomic_store_n (&polybench_inter_array_padding_sz, 0, __ATOMIC_RELAXED);
+      __atomic_store_n (&polybench_inter_array_index, 0, __ATOMIC_RELAXED);
+    }
+}
 
 
 static
 void*
 xmalloc(size_t alloc_sz)
 {
-  void* ret = NULL;
-  /* By default, post-pad the arrays. Safe behavior, but likely useless. */
-  polybench_inter_array_padding_sz += POLYBENCH_INTER_ARRAY_PADDING_FACTOR;
-  size_t padded_sz = alloc_sz + polybench_inter_array_padding_sz;
-  int err = posix_memalign (&ret, 4096, padded_sz);
-  if (! ret || err)
+  struct polybench_block block;
+  char* ret;
+  /* By default, post-pad the arrays. Safe behavior, but likely useless.
+     With inter-array padding, the data is also moved forward by the
+     padding accumulated so far. */
+  size_t shift = __atomic_add_fetch (&polybench_inter_array_padding_sz,
+				     POLYBENCH_INTER_ARRAY_PADDING_FACTOR,
+				     __ATOMIC_RELAXED);
+#ifdef POLYBENCH_INTER_ARRAY_PADDING_OFFSETS
+  const unsigned int nb_offsets =
+    sizeof(polybench_inter_array_offsets) / sizeof(size_t);
+  unsigned int index = __atomic_fetch_add (&polybench_inter_array_index, 1,
+					   __ATOMIC_RELAXED);
+  shift = polybench_inter_array_offsets[index < nb_offsets ? index : nb_offsets - 1];
+#endif
+  size_t padded_sz = alloc_sz + shift;
+  block.base = block_alloc (POLYBENCH_DATA_OFFSET + padded_sz,
+			    &block.len, &block.kind);
+  if (! block.base)
     {
-      fprintf (stderr, "[PolyBench] posix_memalign: cannot allocate memory");
+      fprintf (stderr, "[PolyBench] cannot allocate memory");
       exit (1);
     }
-  /* Safeguard: this is invoked only if polybench.c has been compiled
-     with inter-array padding support from polybench.h. If so, move
-     the starting address of the allocation and return it to the
-     user. The original pointer is registered in an allocation table
-     internal to polybench.c. Data must then be freed using
-     polybench_free_data, which will inspect the allocation table to
-     free the original pointer.*/
-#ifdef POLYBENCH_ENABLE_INTARRAY_PAD
-  /* This moves the 'ret' pointer by (padded_sz - alloc_sz) positions, and
-  registers it in the lookup table for future free using
-  polybench_free_data. */
-  ret = register_padded_pointer(ret, alloc_sz, padded_sz);
+#if POLYBENCH_NUMA_POLICY != POLYBENCH_NUMA_DEFAULT
+  /* Arena pages are already placed by their owner (the harness
+     applies the same policy). */
+  if (block.kind != POLYBENCH_BLOCK_ARENA)
+    numa_place (block.base, block.len);
 #endif
+  block.user_sz = alloc_sz;
+  block.magic = POLYBENCH_BLOCK_MAGIC;
+  /* The padding may leave the descriptor unaligned: copy it. */
+  ret = (char*) block.base + POLYBENCH_DATA_OFFSET + shift;
+  memcpy (ret - sizeof(block), &block, sizeof(block));
+  account_alloc (alloc_sz);
 
   return ret;
 }
@@ -546,20 +781,67 @@ xmalloc(size_t alloc_sz)
 
 void polybench_free_data(void* ptr)
 {
-#ifdef POLYBENCH_ENABLE_INTARRAY_PAD
-  free_data_from_alloc_table (ptr);
-#else
-  free (ptr);
-#endif
+  struct polybench_block block;
+  if (ptr == NULL)
+    return;
+  memcpy (&block, (char*) ptr - sizeof(block), sizeof(block));
+  if (block.magic != POLYBENCH_BLOCK_MAGIC)
+    {
+      /* Should never happen if the API is properly used. */
+      fprintf (stderr, "[ERROR] polybench_free_data requires data allocated with polybench_alloc_data\n");
+      exit (1);
+    }
+  /* Untag the block: freeing it again is reported, as long as the
+     memory is still mapped. */
+  block.magic = 0;
+  memcpy ((char*) ptr - sizeof(block), &block, sizeof(block));
+  account_free (block.user_sz);
+  if (block.kind == POLYBENCH_BLOCK_MAPPED)
+    munmap (block.base, block.len);
+  else if (block.kind == POLYBENCH_BLOCK_MALLOC)
+    free (block.base);
+  /* Arena blocks are reclaimed all at once by polybench_set_arena. */
 }
 
 
-void* polybench_alloc_data(unsigned long long int n, int elt_size)
+void polybench_set_arena(void* base, size_t size)
 {
-#ifdef POLYBENCH_ENABLE_INTARRAY_PAD
-  check_alloc_table_state ();
-#endif
+  polybench_arena_base = (char*) base;
+  polybench_arena_size = base != NULL ? size : 0;
+  __atomic_store_n (&polybench_arena_used, 0, __ATOMIC_RELAXED);
+}
+
+
+void polybench_set_dump_target(FILE* target)
+{
+  polybench_dump_target = target;
+}
+
+
+void polybench_get_alloc_stats(struct polybench_alloc_stats* stats)
+{
+  struct polybench_alloc_stats* st = &polybench_alloc_stats_data;
+  stats->nb_allocs = __atomic_load_n (&st->nb_allocs, __ATOMIC_RELAXED);
+  stats->nb_live = __atomic_load_n (&st->nb_live, __ATOMIC_RELAXED);
+  stats->live_bytes = __atomic_load_n (&st->live_bytes, __ATOMIC_RELAXED);
+  stats->peak_bytes = __atomic_load_n (&st->peak_bytes, __ATOMIC_RELAXED);
+  stats->total_bytes = __atomic_load_n (&st->total_bytes, __ATOMIC_RELAXED);
+}
+
 
+void polybench_reset_alloc_stats()
+{
+  struct polybench_alloc_stats* st = &polybench_alloc_stats_data;
+  __atomic_store_n (&st->peak_bytes,
+		    __atomic_load_n (&st->live_bytes, __ATOMIC_RELAXED),
+		    __ATOMIC_RELAXED);
+  __atomic_store_n (&st->total_bytes, 0, __ATOMIC_RELAXED);
+  __atomic_store_n (&st->nb_allocs, 0, __ATOMIC_RELAXED);
+}
+
+
+void* polybench_alloc_data(unsigned long long int n, int elt_size)
+{
   /// FIXME: detect overflow!
   size_t val = n;
   val *= elt_size;
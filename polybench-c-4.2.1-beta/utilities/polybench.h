@@ -27,6 +27,7 @@
 #ifndef POLYBENCH_H
 # define POLYBENCH_H
 
+# include <stdio.h>
 # include <stdlib.h>
 
 /* Array padding. By default, none is used. */
@@ -73,6 +74,17 @@
 #  define POLYBENCH_RESTRICT
 # endif
 
+/* Hot functions of the optimized kernel variants are compiled for the
+ * SIMD extensions of x86-64 (AVX-512, AVX2 and the baseline ISA), the
+ * best one being selected when the program is loaded. Define
+ * POLYBENCH_NO_ISA_CLONES to compile them for the target ISA only.
+ */
+# if defined(__x86_64__) && defined(__GNUC__) && !defined(POLYBENCH_NO_ISA_CLONES)
+#  define POLYBENCH_ISA_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+# else
+#  define POLYBENCH_ISA_CLONES
+# endif
+
 /* Macros to reference an array. Generic for heap and stack arrays
    (C99).  Each array dimensionality has his own macro, to be used at
    declaration or as a function argument.
@@ -82,11 +94,9 @@
 */
 # ifndef POLYBENCH_STACK_ARRAYS
 #  define POLYBENCH_ARRAY(x) *x
-#  ifdef POLYBENCH_ENABLE_INTARRAY_PAD
-#   define POLYBENCH_FREE_ARRAY(x) polybench_free_data((void*)x);
-#  else
-#   define POLYBENCH_FREE_ARRAY(x) free((void*)x);
-#  endif
+/* Heap arrays may not come from malloc (inter-array padding, huge
+   pages): always release them through polybench.c. */
+#  define POLYBENCH_FREE_ARRAY(x) polybench_free_data((void*)x);
 #  define POLYBENCH_DECL_VAR(x) (*x)
 # else
 #  define POLYBENCH_ARRAY(x) x
@@ -161,7 +171,11 @@
 #  define POLYBENCH_DCE_ONLY_CODE
 # endif
 
-#define POLYBENCH_DUMP_TARGET stderr
+/* print_array writes to stderr, unless a harness redirected the dumps
+   with polybench_set_dump_target. */
+extern FILE* polybench_dump_target;
+#define POLYBENCH_DUMP_TARGET \
+  (polybench_dump_target != NULL ? polybench_dump_target : stderr)
 #define POLYBENCH_DUMP_START    fprintf(POLYBENCH_DUMP_TARGET, "==BEGIN DUMP_ARRAYS==\n")
 #define POLYBENCH_DUMP_FINISH   fprintf(POLYBENCH_DUMP_TARGET, "==END   DUMP_ARRAYS==\n")
 #define POLYBENCH_DUMP_BEGIN(s) fprintf(POLYBENCH_DUMP_TARGET, "begin dump: %s", s)
@@ -231,6 +245,28 @@ extern void polybench_papi_print();
 extern void* polybench_alloc_data(unsigned long long int n, int elt_size);
 extern void polybench_free_data(void* ptr);
 
+/* Harness support: measure of the last timed region, and accounting
+   of the data allocated with polybench_alloc_data. */
+struct polybench_alloc_stats
+{
+  unsigned long long nb_allocs;   /* allocations since the last reset */
+  unsigned long long nb_live;     /* blocks not freed yet */
+  unsigned long long live_bytes;  /* bytes not freed yet */
+  unsigned long long peak_bytes;  /* max of live_bytes since the last reset */
+  unsigned long long total_bytes; /* bytes allocated since the last reset */
+};
+extern double polybench_timer_get_elapsed();
+extern void polybench_get_alloc_stats(struct polybench_alloc_stats* stats);
+extern void polybench_reset_alloc_stats();
+/* Serve polybench_alloc_data from [base, base+size) until the next
+   call, falling back to the system allocator when it is full. The
+   arena is reset by every call, and disabled by a NULL base. Blocks
+   taken from it are not released by polybench_free_data. */
+extern void polybench_set_arena(void* base, size_t size);
+/* Dump the live-out data to target instead of stderr, or to stderr
+   again with NULL. */
+extern void polybench_set_dump_target(FILE* target);
+
 /* PolyBench internal functions that should not be directly called by */
 /* the user, unless when designing customized execution profiling */
 /* approaches. */
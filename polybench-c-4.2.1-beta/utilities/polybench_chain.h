@@ -0,0 +1,357 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/*
+ * polybench_chain.h: this file is part of PolyBench/C
+ *
+ * Fused evaluation of matrix chains, X := alpha * M0 * M1 * ... + beta * X,
+ * for the chained-product kernels (2mm, 3mm). Include after the kernel
+ * header, as it uses DATA_TYPE.
+ *
+ * The multiplication order is the cheapest one for the actual dimensions
+ * (matrix-chain dynamic programming on the number of multiplications).
+ * The chain is then evaluated by row panels: the rows of a product only
+ * depend on the same rows of its left operand, so the left operands of
+ * the product tree are computed panel by panel, CHAIN_ROWS rows at a
+ * time, and stay in cache until consumed. Only right operands that are
+ * themselves products are materialized, before streaming starts.
+ *
+ * With POLYBENCH_TIME, polybench_chain_report prints the order and the
+ * traffic estimated by polybench_chain_bytes between memory and a cache
+ * of CHAIN_CACHE bytes, for this evaluation or for the unfused loop
+ * nests of the reference kernels, which go through the result row by
+ * row and write every intermediate product back to memory.
+ */
+#ifndef POLYBENCH_CHAIN_H
+# define POLYBENCH_CHAIN_H
+
+# include <stdio.h>
+# include <string.h>
+
+/* Longest chain. */
+# ifndef CHAIN_MAX
+#  define CHAIN_MAX 8
+# endif
+/* Rows of the panels streamed through the cache. */
+# ifndef CHAIN_ROWS
+#  define CHAIN_ROWS 32
+# endif
+/* Inner and column blocking of the panel products. */
+# ifndef CHAIN_KB
+#  define CHAIN_KB 128
+# endif
+# ifndef CHAIN_NB
+#  define CHAIN_NB 256
+# endif
+/* Cache size of the traffic model, in bytes. */
+# ifndef CHAIN_CACHE
+#  define CHAIN_CACHE (1 << 20)
+# endif
+
+/* Matrix i of a chain is dims[i] x dims[i+1]; split[i][j] is the last
+   matrix of the left operand of the product of matrices i to j. */
+typedef struct
+{
+  int n;
+  long dims[CHAIN_MAX + 1];
+  int split[CHAIN_MAX][CHAIN_MAX];
+} polybench_chain_plan_t;
+
+/* Evaluation state: operands, and the buffers of the products. */
+typedef struct
+{
+  const polybench_chain_plan_t* plan;
+  const DATA_TYPE* mat[CHAIN_MAX];
+  int ld[CHAIN_MAX];
+  DATA_TYPE* full[CHAIN_MAX][CHAIN_MAX];   /* materialized products */
+  DATA_TYPE* panel[CHAIN_MAX][CHAIN_MAX];  /* row panels of products */
+} polybench_chain_t;
+
+
+/* Fills plan->split with the order of fewest multiplications. */
+static
+void polybench_chain_optimize (polybench_chain_plan_t* plan)
+{
+  double cost[CHAIN_MAX][CHAIN_MAX];
+  int len, i, j, k;
+
+  for (i = 0; i < plan->n; i++)
+    cost[i][i] = 0;
+  for (len = 2; len <= plan->n; len++)
+    for (i = 0; i + len <= plan->n; i++)
+      {
+	j = i + len - 1;
+	cost[i][j] = -1;
+	for (k = i; k < j; k++)
+	  {
+	    double c = cost[i][k] + cost[k + 1][j]
+	      + (double) plan->dims[i] * plan->dims[k + 1] * plan->dims[j + 1];
+	    if (cost[i][j] < 0 || c < cost[i][j])
+	      {
+		cost[i][j] = c;
+		plan->split[i][j] = k;
+	      }
+	  }
+      }
+}
+
+
+# ifdef POLYBENCH_TIME
+
+/* Multiplications of the product of matrices i to j. */
+static
+double polybench_chain_flops_of (const polybench_chain_plan_t* plan, int i, int j)
+{
+  int k = plan->split[i][j];
+
+  if (i == j)
+    return 0;
+  return polybench_chain_flops_of (plan, i, k)
+    + polybench_chain_flops_of (plan, k + 1, j)
+    + (double) plan->dims[i] * plan->dims[k + 1] * plan->dims[j + 1];
+}
+
+
+static
+double polybench_chain_flops (const polybench_chain_plan_t* plan)
+{
+  return polybench_chain_flops_of (plan, 0, plan->n - 1);
+}
+
+
+/* Bytes moved by the product of matrices i to j, its rows being
+   produced by panels of CHAIN_ROWS rows (fused) or one row at a time,
+   and written to memory when materialized. */
+static
+double polybench_chain_bytes_of (const polybench_chain_plan_t* plan,
+				 int i, int j, int fused, int materialized)
+{
+  double s = sizeof (DATA_TYPE);
+  double m, inner, n, right, bytes = 0;
+  int k;
+
+  if (i == j)
+    return 0;
+  k = plan->split[i][j];
+  m = plan->dims[i];
+  inner = plan->dims[k + 1];
+  n = plan->dims[j + 1];
+  /* Left operand: read once, or kept in cache when fused. */
+  if (k == i)
+    bytes += m * inner * s;
+  else
+    bytes += polybench_chain_bytes_of (plan, i, k, fused, !fused)
+      + (fused ? 0 : m * inner * s);
+  /* Right operand: computed beforehand, then streamed again for every
+     panel (or row) unless it fits in cache. */
+  right = inner * n * s;
+  bytes += polybench_chain_bytes_of (plan, k + 1, j, fused, 1);
+  if (right <= CHAIN_CACHE)
+    bytes += right;
+  else
+    bytes += right * (fused ? (m + CHAIN_ROWS - 1) / CHAIN_ROWS : m);
+  if (materialized)
+    bytes += m * n * s;
+  return bytes;
+}
+
+
+/* Bytes moved by X := alpha * chain + beta * X. */
+static
+double polybench_chain_bytes (const polybench_chain_plan_t* plan, int fused)
+{
+  double out = (double) plan->dims[0] * plan->dims[plan->n] * sizeof (DATA_TYPE);
+
+  /* X is read for beta, and written. */
+  return polybench_chain_bytes_of (plan, 0, plan->n - 1, fused, 0) + 2 * out;
+}
+
+
+/* Parenthesized order, e.g. ((AB)C) for names "ABC". */
+static
+void polybench_chain_order_of (const polybench_chain_plan_t* plan, int i, int j,
+			       const char* names, char* out)
+{
+  int k = plan->split[i][j];
+  size_t len = strlen (out);
+
+  if (i == j)
+    {
+      out[len] = names[i];
+      out[len + 1] = '\0';
+      return;
+    }
+  strcat (out, "(");
+  polybench_chain_order_of (plan, i, k, names, out);
+  polybench_chain_order_of (plan, k + 1, j, names, out);
+  strcat (out, ")");
+}
+
+
+/* One line on stdout: order, multiplications, and bytes moved by the
+   fused evaluation of plan and by the reference order ref, unfused. */
+static
+void polybench_chain_report (const polybench_chain_plan_t* plan,
+			     const polybench_chain_plan_t* ref,
+			     const char* names)
+{
+  char order[4 * CHAIN_MAX] = "", ref_order[4 * CHAIN_MAX] = "";
+  double bytes = polybench_chain_bytes (plan, 1);
+  double ref_bytes = polybench_chain_bytes (ref, 0);
+
+  polybench_chain_order_of (plan, 0, plan->n - 1, names, order);
+  polybench_chain_order_of (ref, 0, ref->n - 1, names, ref_order);
+  printf ("chain %s flops=%.0f bytes=%.0f reference %s flops=%.0f bytes=%.0f"
+	  " traffic_ratio=%.2f\n",
+	  order, polybench_chain_flops (plan), bytes,
+	  ref_order, polybench_chain_flops (ref), ref_bytes,
+	  bytes > 0 ? ref_bytes / bytes : 0);
+}
+
+# endif /* POLYBENCH_TIME */
+
+
+/* X[0:rows][0:n] := L[0:rows][0:nk] * R[0:nk][0:n], with a CHAIN_KB x
+   CHAIN_NB block of R reused by every row of the panel. */
+static
+void polybench_chain_panel_product (int rows, int nk, int n,
+				    const DATA_TYPE* L, int ldl,
+				    const DATA_TYPE* R, int ldr,
+				    DATA_TYPE* X, int ldx)
+{
+  int i, j, k, jj, kk;
+
+  for (jj = 0; jj < n; jj += CHAIN_NB)
+    {
+      int j1 = jj + CHAIN_NB < n ? jj + CHAIN_NB : n;
+      for (i = 0; i < rows; i++)
+	for (j = jj; j < j1; j++)
+	  X[i * ldx + j] = 0;
+      for (kk = 0; kk < nk; kk += CHAIN_KB)
+	for (i = 0; i < rows; i++)
+	  for (k = kk; k < kk + CHAIN_KB && k < nk; k++)
+	    {
+	      DATA_TYPE l = L[i * ldl + k];
+	      for (j = jj; j < j1; j++)
+		X[i * ldx + j] += l * R[k * ldr + j];
+	    }
+    }
+}
+
+
+/* Rows r0 to r0+rows of the product of matrices i to j, into dst (or a
+   panel buffer when dst is NULL). Returns where they are. */
+static
+const DATA_TYPE* polybench_chain_rows (polybench_chain_t* c, int i, int j,
+				       int r0, int rows,
+				       DATA_TYPE* dst, int ldd, int* ld)
+{
+  const polybench_chain_plan_t* plan = c->plan;
+  const DATA_TYPE *left, *right;
+  int k, ldl, ldr;
+
+  if (i == j)
+    {
+      *ld = c->ld[i];
+      return c->mat[i] + (long) r0 * c->ld[i];
+    }
+  k = plan->split[i][j];
+  left = polybench_chain_rows (c, i, k, r0, rows, NULL, 0, &ldl);
+  if (k + 1 == j)
+    {
+      right = c->mat[j];
+      ldr = c->ld[j];
+    }
+  else
+    {
+      right = c->full[k + 1][j];
+      ldr = (int) plan->dims[j + 1];
+    }
+  if (!dst)
+    {
+      if (!c->panel[i][j])
+	c->panel[i][j] = (DATA_TYPE*)
+	  polybench_alloc_data (CHAIN_ROWS * plan->dims[j + 1], sizeof (DATA_TYPE));
+      dst = c->panel[i][j];
+      ldd = (int) plan->dims[j + 1];
+    }
+  polybench_chain_panel_product (rows, (int) plan->dims[k + 1], (int) plan->dims[j + 1],
+				 left, ldl, right, ldr, dst, ldd);
+  *ld = ldd;
+  return dst;
+}
+
+
+/* Materializes the right operands that are products, innermost first. */
+static
+void polybench_chain_prepare (polybench_chain_t* c, int i, int j)
+{
+  const polybench_chain_plan_t* plan = c->plan;
+  int k, r0, ld;
+
+  if (i == j)
+    return;
+  k = plan->split[i][j];
+  polybench_chain_prepare (c, i, k);
+  polybench_chain_prepare (c, k + 1, j);
+  if (k + 1 == j)
+    return;
+  c->full[k + 1][j] = (DATA_TYPE*)
+    polybench_alloc_data (plan->dims[k + 1] * plan->dims[j + 1], sizeof (DATA_TYPE));
+  for (r0 = 0; r0 < plan->dims[k + 1]; r0 += CHAIN_ROWS)
+    polybench_chain_rows (c, k + 1, j, r0,
+			  r0 + CHAIN_ROWS < plan->dims[k + 1]
+			  ? CHAIN_ROWS : (int) plan->dims[k + 1] - r0,
+			  c->full[k + 1][j] + r0 * plan->dims[j + 1],
+			  (int) plan->dims[j + 1], &ld);
+}
+
+
+/* X := alpha * M0 * ... * Mn-1 + beta * X, matrix i being mat[i] with
+   rows of ld[i] elements. With scale 0, X := alpha * M0 * ... only. */
+static
+void polybench_chain_run (const polybench_chain_plan_t* plan,
+			  const DATA_TYPE* const* mat, const int* ld,
+			  DATA_TYPE alpha, DATA_TYPE beta, int scale,
+			  DATA_TYPE* X, int ldx)
+{
+  polybench_chain_t c;
+  const DATA_TYPE* rows;
+  int i, j, r, r0, nb, ldr;
+  int m = (int) plan->dims[0], n = (int) plan->dims[plan->n];
+
+  memset (&c, 0, sizeof (c));
+  c.plan = plan;
+  for (i = 0; i < plan->n; i++)
+    {
+      c.mat[i] = mat[i];
+      c.ld[i] = ld[i];
+    }
+  polybench_chain_prepare (&c, 0, plan->n - 1);
+  for (r0 = 0; r0 < m; r0 += CHAIN_ROWS)
+    {
+      nb = r0 + CHAIN_ROWS < m ? CHAIN_ROWS : m - r0;
+      rows = polybench_chain_rows (&c, 0, plan->n - 1, r0, nb, NULL, 0, &ldr);
+      for (r = 0; r < nb; r++)
+	for (j = 0; j < n; j++)
+	  X[(r0 + r) * ldx + j] = scale
+	    ? beta * X[(r0 + r) * ldx + j] + alpha * rows[r * ldr + j]
+	    : alpha * rows[r * ldr + j];
+    }
+  for (i = 0; i < plan->n; i++)
+    for (j = 0; j < plan->n; j++)
+      {
+	if (c.full[i][j])
+	  polybench_free_data (c.full[i][j]);
+	if (c.panel[i][j])
+	  polybench_free_data (c.panel[i][j]);
+      }
+}
+
+#endif /* !POLYBENCH_CHAIN_H */
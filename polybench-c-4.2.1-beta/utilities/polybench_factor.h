@@ -0,0 +1,326 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/*
+ * polybench_factor.h: this file is part of PolyBench/C
+ *
+ * Right-looking blocked factorizations of the solver kernels: Cholesky
+ * (cholesky) and LU without pivoting (lu, ludcmp), in place. Include
+ * after the kernel header, as it uses DATA_TYPE, and define FACTOR_LU or
+ * FACTOR_CHOLESKY first to select the factorization.
+ *
+ * The matrix is cut into FACTOR_NB x FACTOR_NB tiles. Step k factors the
+ * diagonal tile, solves the tiles of the panel against it, and updates
+ * the trailing tiles with a matrix product. Every tile operation is an
+ * OpenMP task whose dependencies on the tiles it reads and writes are
+ * declared, so that the runtime starts the panel of step k+1 as soon as
+ * its tiles are updated instead of waiting for the whole trailing
+ * matrix. Build with -fopenmp; -DPOLYBENCH_THREADS=N sets the number of
+ * threads. Without OpenMP the tasks run in program order. The tile
+ * operations are cloned for AVX-512, AVX2 and the baseline ISA
+ * (POLYBENCH_ISA_CLONES), hence -O3 to vectorize them.
+ *
+ * Every element goes through the same sequence of operations as in the
+ * unblocked loops of the reference kernels (updates in increasing k,
+ * then the division), only scheduled differently.
+ */
+#ifndef POLYBENCH_FACTOR_H
+# define POLYBENCH_FACTOR_H
+
+# include <stdlib.h>
+# ifdef _OPENMP
+#  include <omp.h>
+# endif
+
+/* Tile size. */
+# ifndef FACTOR_NB
+#  define FACTOR_NB 128
+# endif
+
+/* Size of tile i of a n x n matrix. */
+# define FACTOR_TILE(i, n) \
+  ((i) * FACTOR_NB + FACTOR_NB < (n) ? FACTOR_NB : (n) - (i) * FACTOR_NB)
+
+
+/* C[0:m][0:n] -= A[0:m][0:kd] * B[0:kd][0:n], only c <= r when lower */
+static POLYBENCH_ISA_CLONES
+void polybench_factor_update (int m, int n, int kd, int lower,
+			      DATA_TYPE* POLYBENCH_RESTRICT C, int ldc,
+			      const DATA_TYPE* POLYBENCH_RESTRICT A, int lda,
+			      const DATA_TYPE* POLYBENCH_RESTRICT B, int ldb)
+{
+  int r, c, k;
+
+  for (r = 0; r < m; r++)
+    {
+      DATA_TYPE* cr = C + r * ldc;
+      int ce = lower && r + 1 < n ? r + 1 : n;
+      for (k = 0; k < kd; k++)
+	{
+	  DATA_TYPE a = A[r * lda + k];
+	  const DATA_TYPE* bk = B + k * ldb;
+	  for (c = 0; c < ce; c++)
+	    cr[c] -= a * bk[c];
+	}
+    }
+}
+
+
+# ifdef FACTOR_LU
+
+/* Rows 0:m of A[0:m][0:n] against the upper factor of the diagonal tile
+   U (whose rows are final): for every row r and column j < limit (r on
+   the diagonal tile, which is then U itself, n otherwise), A[r][j] is
+   divided by U[j][j] and its multiple of row j of U subtracted from the
+   rest of the row. */
+static POLYBENCH_ISA_CLONES
+void polybench_factor_getrf_rows (int m, int n, int diagonal,
+				  DATA_TYPE* A, int lda,
+				  const DATA_TYPE* U, int ldu)
+{
+  int r, j, c;
+
+  for (r = 0; r < m; r++)
+    {
+      DATA_TYPE* ar = A + r * lda;
+      int limit = diagonal ? r : n;
+      for (j = 0; j < limit; j++)
+	{
+	  DATA_TYPE a;
+	  const DATA_TYPE* uj = U + j * ldu;
+	  ar[j] /= uj[j];
+	  a = ar[j];
+	  for (c = j + 1; c < n; c++)
+	    ar[c] -= a * uj[c];
+	}
+    }
+}
+
+
+/* B[0:n][0:m] := L^-1 B, L[0:n][0:n] being the unit lower factor of
+   the diagonal tile. */
+static POLYBENCH_ISA_CLONES
+void polybench_factor_trsm_lu (int n, int m,
+			       DATA_TYPE* POLYBENCH_RESTRICT B, int ldb,
+			       const DATA_TYPE* POLYBENCH_RESTRICT L, int ldl)
+{
+  int r, k, c;
+
+  for (r = 0; r < n; r++)
+    for (k = 0; k < r; k++)
+      {
+	DATA_TYPE l = L[r * ldl + k];
+	for (c = 0; c < m; c++)
+	  B[r * ldb + c] -= l * B[k * ldb + c];
+      }
+}
+
+
+/* A[0:n][0:n] := L U, L unit lower, without pivoting. */
+static
+void polybench_factor_lu (int n, DATA_TYPE* A, int lda)
+{
+  const int nt = (n + FACTOR_NB - 1) / FACTOR_NB;
+  char* dep = (char*) calloc ((size_t) nt * nt + 1, 1);
+
+  if (dep == NULL)
+    abort ();
+
+# if defined(_OPENMP) && defined(POLYBENCH_THREADS)
+  omp_set_num_threads (POLYBENCH_THREADS);
+# endif
+#pragma omp parallel
+#pragma omp single
+  {
+    int i, j, k;
+    for (k = 0; k < nt; k++)
+      {
+	DATA_TYPE* akk = A + (long) k * FACTOR_NB * (lda + 1);
+	int nk = FACTOR_TILE (k, n);
+#pragma omp task firstprivate(akk, nk) depend(inout: dep[k * nt + k])
+	polybench_factor_getrf_rows (nk, nk, 1, akk, lda, akk, lda);
+	for (j = k + 1; j < nt; j++)
+	  {
+	    /* row panel: U[k][j] := L[k][k]^-1 A[k][j] */
+	    DATA_TYPE* akj = A + (long) k * FACTOR_NB * lda + j * FACTOR_NB;
+	    int nj = FACTOR_TILE (j, n);
+#pragma omp task firstprivate(akk, akj, nk, nj) depend(in: dep[k * nt + k]) \
+  depend(inout: dep[k * nt + j])
+	    polybench_factor_trsm_lu (nk, nj, akj, lda, akk, lda);
+	  }
+	for (i = k + 1; i < nt; i++)
+	  {
+	    /* column panel: L[i][k] := A[i][k] U[k][k]^-1 */
+	    DATA_TYPE* aik = A + (long) i * FACTOR_NB * lda + k * FACTOR_NB;
+	    int ni = FACTOR_TILE (i, n);
+#pragma omp task firstprivate(akk, aik, nk, ni) depend(in: dep[k * nt + k]) \
+  depend(inout: dep[i * nt + k])
+	    polybench_factor_getrf_rows (ni, nk, 0, aik, lda, akk, lda);
+	  }
+	for (i = k + 1; i < nt; i++)
+	  for (j = k + 1; j < nt; j++)
+	    {
+	      DATA_TYPE* aij = A + (long) i * FACTOR_NB * lda + j * FACTOR_NB;
+	      DATA_TYPE* aik = A + (long) i * FACTOR_NB * lda + k * FACTOR_NB;
+	      DATA_TYPE* akj = A + (long) k * FACTOR_NB * lda + j * FACTOR_NB;
+	      int ni = FACTOR_TILE (i, n), nj = FACTOR_TILE (j, n);
+#pragma omp task firstprivate(aij, aik, akj, ni, nj, nk) \
+  depend(in: dep[i * nt + k], dep[k * nt + j]) depend(inout: dep[i * nt + j])
+	      polybench_factor_update (ni, nj, nk, 0, aij, lda, aik, lda, akj, lda);
+	    }
+      }
+  }
+  free (dep);
+}
+
+
+# endif /* FACTOR_LU */
+
+
+/* The Cholesky tile operations need the SQRT_FUN of the kernel header. */
+# ifdef FACTOR_CHOLESKY
+
+static
+DATA_TYPE* polybench_factor_scratch (void)
+{
+  DATA_TYPE* s = (DATA_TYPE*) malloc (FACTOR_NB * FACTOR_NB * sizeof (DATA_TYPE));
+
+  if (s == NULL)
+    abort ();
+  return s;
+}
+
+
+/* D[0:n][0:m] := S[0:m][0:n]^T */
+static
+void polybench_factor_transpose (int m, int n,
+				 const DATA_TYPE* S, int lds,
+				 DATA_TYPE* D, int ldd)
+{
+  int i, j;
+
+  for (i = 0; i < m; i++)
+    for (j = 0; j < n; j++)
+      D[j * ldd + i] = S[i * lds + j];
+}
+
+
+/* Cholesky factorization of the diagonal tile A[0:n][0:n], lower
+   triangle. */
+static
+void polybench_factor_potrf (int n, DATA_TYPE* A, int lda)
+{
+  int i, j, k;
+
+  for (i = 0; i < n; i++)
+    {
+      for (j = 0; j < i; j++)
+	{
+	  for (k = 0; k < j; k++)
+	    A[i * lda + j] -= A[i * lda + k] * A[j * lda + k];
+	  A[i * lda + j] /= A[j * lda + j];
+	}
+      for (k = 0; k < i; k++)
+	A[i * lda + i] -= A[i * lda + k] * A[i * lda + k];
+      A[i * lda + i] = SQRT_FUN(A[i * lda + i]);
+    }
+}
+
+
+/* X[0:m][0:n] := X * L^-T, L[0:n][0:n] being a factored diagonal tile.
+   Computed on the transpose of X, in T, so that rows of X are updated
+   with unit stride. */
+static POLYBENCH_ISA_CLONES
+void polybench_factor_trsm_llt (int m, int n,
+				DATA_TYPE* X, int ldx,
+				const DATA_TYPE* L, int ldl,
+				DATA_TYPE* POLYBENCH_RESTRICT T)
+{
+  int r, c, k;
+
+  polybench_factor_transpose (m, n, X, ldx, T, FACTOR_NB);
+  for (c = 0; c < n; c++)
+    {
+      DATA_TYPE* tc = T + c * FACTOR_NB;
+      DATA_TYPE d = L[c * ldl + c];
+      for (k = 0; k < c; k++)
+	{
+	  DATA_TYPE l = L[c * ldl + k];
+	  const DATA_TYPE* tk = T + k * FACTOR_NB;
+	  for (r = 0; r < m; r++)
+	    tc[r] -= tk[r] * l;
+	}
+      for (r = 0; r < m; r++)
+	tc[r] /= d;
+    }
+  polybench_factor_transpose (n, m, T, FACTOR_NB, X, ldx);
+}
+
+
+/* A[0:n][0:n] := L L^T, lower triangle. */
+static
+void polybench_factor_cholesky (int n, DATA_TYPE* A, int lda)
+{
+  const int nt = (n + FACTOR_NB - 1) / FACTOR_NB;
+  char* dep = (char*) calloc ((size_t) nt * nt + 1, 1);
+
+  if (dep == NULL)
+    abort ();
+
+# if defined(_OPENMP) && defined(POLYBENCH_THREADS)
+  omp_set_num_threads (POLYBENCH_THREADS);
+# endif
+#pragma omp parallel
+#pragma omp single
+  {
+    int i, j, k;
+    for (k = 0; k < nt; k++)
+      {
+	DATA_TYPE* akk = A + (long) k * FACTOR_NB * (lda + 1);
+	int nk = FACTOR_TILE (k, n);
+#pragma omp task firstprivate(akk, nk) depend(inout: dep[k * nt + k])
+	polybench_factor_potrf (nk, akk, lda);
+	for (i = k + 1; i < nt; i++)
+	  {
+	    DATA_TYPE* aik = A + (long) i * FACTOR_NB * lda + k * FACTOR_NB;
+	    int ni = FACTOR_TILE (i, n);
+#pragma omp task firstprivate(akk, aik, nk, ni) depend(in: dep[k * nt + k]) \
+  depend(inout: dep[i * nt + k])
+	    {
+	      DATA_TYPE* t = polybench_factor_scratch ();
+	      polybench_factor_trsm_llt (ni, nk, aik, lda, akk, lda, t);
+	      free (t);
+	    }
+	  }
+	for (i = k + 1; i < nt; i++)
+	  for (j = k + 1; j <= i; j++)
+	    {
+	      DATA_TYPE* aij = A + (long) i * FACTOR_NB * lda + j * FACTOR_NB;
+	      DATA_TYPE* aik = A + (long) i * FACTOR_NB * lda + k * FACTOR_NB;
+	      DATA_TYPE* ajk = A + (long) j * FACTOR_NB * lda + k * FACTOR_NB;
+	      int ni = FACTOR_TILE (i, n), nj = FACTOR_TILE (j, n);
+#pragma omp task firstprivate(aij, aik, ajk, ni, nj, nk, i, j) \
+  depend(in: dep[i * nt + k], dep[j * nt + k]) depend(inout: dep[i * nt + j])
+	      {
+		/* A[i][j] -= A[i][k] A[j][k]^T */
+		DATA_TYPE* t = polybench_factor_scratch ();
+		polybench_factor_transpose (nj, nk, ajk, lda, t, FACTOR_NB);
+		polybench_factor_update (ni, nj, nk, i == j, aij, lda,
+					 aik, lda, t, FACTOR_NB);
+		free (t);
+	      }
+	    }
+      }
+  }
+  free (dep);
+}
+
+# endif /* FACTOR_CHOLESKY */
+
+#endif /* !POLYBENCH_FACTOR_H */
@@ -0,0 +1,272 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/*
+ * polybench_matvec.h: this file is part of PolyBench/C
+ *
+ * Single-pass matrix-vector engine of the bandwidth-bound kernels (atax,
+ * bicg, mvt, gesummv, gemver). Include after the kernel header, as it
+ * uses DATA_TYPE.
+ *
+ * y := A x and z := A^T w are computed in one streaming pass over the
+ * rows of A, MATVEC_ROWS rows at a time: the dot products of the rows
+ * use one accumulator per row, and their contribution to z is added in a
+ * single sweep of z. Rows are split between OpenMP threads, each of them
+ * accumulating z into a partial vector of its own; the partial vectors
+ * are summed once every row is done. An optional rank-2 update of A
+ * (gemver) is applied to the rows on the same pass.
+ *
+ * With POLYBENCH_TIME and POLYBENCH_MATVEC_REPORT, polybench_matvec_report
+ * prints the bandwidth achieved by a kernel against the one of a STREAM
+ * triad on the same machine. The triad allocates and streams three arrays
+ * of MATVEC_STREAM_SIZE doubles, so it is not part of the timed runs of
+ * the harness, which always defines POLYBENCH_TIME.
+ */
+#ifndef POLYBENCH_MATVEC_H
+# define POLYBENCH_MATVEC_H
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <time.h>
+# ifdef _OPENMP
+#  include <omp.h>
+# endif
+
+/* Rows of a step of the pass (one accumulator each). */
+# define MATVEC_ROWS 4
+/* Elements of the arrays of the STREAM triad. */
+# ifndef MATVEC_STREAM_SIZE
+#  define MATVEC_STREAM_SIZE (1 << 23)
+# endif
+
+/* One pass over A, m x n with rows lda elements apart. Outputs are
+   overwritten, unused ones are NULL. */
+typedef struct
+{
+  int m;
+  int n;
+  DATA_TYPE* A;
+  int lda;
+  /* A := A + u1 v1^T + u2 v2^T first, when u1 is not NULL */
+  const DATA_TYPE* u1;
+  const DATA_TYPE* v1;
+  const DATA_TYPE* u2;
+  const DATA_TYPE* v2;
+  /* y := A x */
+  const DATA_TYPE* x;
+  DATA_TYPE* y;
+  /* z := A^T w; w may be y, z then being A^T A x */
+  const DATA_TYPE* w;
+  DATA_TYPE* z;
+} polybench_matvec_t;
+
+
+/* Rows i0 to i1 (at most MATVEC_ROWS), z accumulated into zp. */
+static POLYBENCH_ISA_CLONES
+void polybench_matvec_rows (const polybench_matvec_t* mv, int i0, int i1,
+			    DATA_TYPE* POLYBENCH_RESTRICT zp)
+{
+  const int n = mv->n;
+  DATA_TYPE* a0 = mv->A + (long) i0 * mv->lda;
+  DATA_TYPE *a1, *a2, *a3;
+  const DATA_TYPE* POLYBENCH_RESTRICT x = mv->x;
+  int i, j;
+
+  if (i1 - i0 < MATVEC_ROWS)
+    {
+      for (i = i0; i < i1; i++, a0 += mv->lda)
+	{
+	  DATA_TYPE s = 0;
+	  if (mv->u1)
+	    for (j = 0; j < n; j++)
+	      a0[j] = a0[j] + mv->u1[i] * mv->v1[j] + mv->u2[i] * mv->v2[j];
+	  if (mv->y)
+	    {
+#pragma omp simd reduction(+:s)
+	      for (j = 0; j < n; j++)
+		s += a0[j] * x[j];
+	      mv->y[i] = s;
+	    }
+	  if (zp)
+	    {
+	      DATA_TYPE w0 = mv->w[i];
+#pragma omp simd
+	      for (j = 0; j < n; j++)
+		zp[j] += a0[j] * w0;
+	    }
+	}
+      return;
+    }
+  a1 = a0 + mv->lda;
+  a2 = a1 + mv->lda;
+  a3 = a2 + mv->lda;
+  if (mv->u1)
+    {
+      const DATA_TYPE* POLYBENCH_RESTRICT v1 = mv->v1;
+      const DATA_TYPE* POLYBENCH_RESTRICT v2 = mv->v2;
+      const DATA_TYPE* u1 = mv->u1 + i0;
+      const DATA_TYPE* u2 = mv->u2 + i0;
+#pragma omp simd
+      for (j = 0; j < n; j++)
+	{
+	  a0[j] = a0[j] + u1[0] * v1[j] + u2[0] * v2[j];
+	  a1[j] = a1[j] + u1[1] * v1[j] + u2[1] * v2[j];
+	  a2[j] = a2[j] + u1[2] * v1[j] + u2[2] * v2[j];
+	  a3[j] = a3[j] + u1[3] * v1[j] + u2[3] * v2[j];
+	}
+    }
+  if (mv->y)
+    {
+      DATA_TYPE s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+#pragma omp simd reduction(+:s0,s1,s2,s3)
+      for (j = 0; j < n; j++)
+	{
+	  s0 += a0[j] * x[j];
+	  s1 += a1[j] * x[j];
+	  s2 += a2[j] * x[j];
+	  s3 += a3[j] * x[j];
+	}
+      mv->y[i0] = s0;
+      mv->y[i0 + 1] = s1;
+      mv->y[i0 + 2] = s2;
+      mv->y[i0 + 3] = s3;
+    }
+  if (zp)
+    {
+      DATA_TYPE w0 = mv->w[i0], w1 = mv->w[i0 + 1];
+      DATA_TYPE w2 = mv->w[i0 + 2], w3 = mv->w[i0 + 3];
+#pragma omp simd
+      for (j = 0; j < n; j++)
+	zp[j] += a0[j] * w0 + a1[j] * w1 + a2[j] * w2 + a3[j] * w3;
+    }
+}
+
+
+static
+void polybench_matvec (const polybench_matvec_t* mv)
+{
+  const int groups = (mv->m + MATVEC_ROWS - 1) / MATVEC_ROWS;
+  /* partial vectors on separate cache lines */
+  const long ldz = (mv->n + 15) & ~15L;
+  int nb_partials = 1;
+  DATA_TYPE* partial = NULL;
+
+# ifdef _OPENMP
+#  ifdef POLYBENCH_THREADS
+  omp_set_num_threads (POLYBENCH_THREADS);
+#  endif
+  nb_partials = omp_get_max_threads ();
+# endif
+  if (mv->z)
+    {
+      partial = (DATA_TYPE*) calloc (nb_partials * ldz, sizeof (DATA_TYPE));
+      if (partial == NULL)
+	abort ();
+    }
+#pragma omp parallel
+  {
+    int g, j, t;
+    DATA_TYPE* zp = NULL;
+    if (partial)
+      {
+# ifdef _OPENMP
+	zp = partial + omp_get_thread_num () * ldz;
+# else
+	zp = partial;
+# endif
+      }
+#pragma omp for schedule(static)
+    for (g = 0; g < groups; g++)
+      polybench_matvec_rows (mv, g * MATVEC_ROWS,
+			     g * MATVEC_ROWS + MATVEC_ROWS < mv->m ?
+			     g * MATVEC_ROWS + MATVEC_ROWS : mv->m, zp);
+    if (partial)
+      {
+#pragma omp for schedule(static)
+	for (j = 0; j < mv->n; j++)
+	  {
+	    DATA_TYPE s = 0;
+	    for (t = 0; t < nb_partials; t++)
+	      s += partial[t * ldz + j];
+	    mv->z[j] = s;
+	  }
+      }
+  }
+  free (partial);
+}
+
+# if defined(POLYBENCH_TIME) && defined(POLYBENCH_MATVEC_REPORT)
+
+static
+double polybench_matvec_clock (void)
+{
+  struct timespec ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+/* Best bandwidth of a STREAM triad, a := b + s * c, in GB/s, counting
+   the reads of b and c and the write of a like STREAM does. */
+static
+double polybench_stream_bandwidth (void)
+{
+  const long n = MATVEC_STREAM_SIZE;
+  double* a = (double*) malloc (n * sizeof (double));
+  double* b = (double*) malloc (n * sizeof (double));
+  double* c = (double*) malloc (n * sizeof (double));
+  double best = 0;
+  long i;
+  int r;
+
+  if (a == NULL || b == NULL || c == NULL)
+    abort ();
+#pragma omp parallel for schedule(static)
+  for (i = 0; i < n; i++)
+    {
+      a[i] = 0;
+      b[i] = 1;
+      c[i] = 2;
+    }
+  for (r = 0; r < 5; r++)
+    {
+      double t = polybench_matvec_clock ();
+#pragma omp parallel for schedule(static)
+      for (i = 0; i < n; i++)
+	a[i] = b[i] + 3 * c[i];
+      t = polybench_matvec_clock () - t;
+      if (t > 0 && (best == 0 || t < best))
+	best = t;
+    }
+  /* keep the triad live */
+  if (a[n / 2] != 7)
+    abort ();
+  free (a);
+  free (b);
+  free (c);
+  return best > 0 ? 3.0 * n * sizeof (double) / best * 1e-9 : 0;
+}
+
+
+/* Bandwidth of a kernel that moved bytes in seconds, against the one of
+   the STREAM triad. */
+static
+void polybench_matvec_report (const char* kernel, double bytes, double seconds)
+{
+  double gbs = seconds > 0 ? bytes / seconds * 1e-9 : 0;
+  double stream = polybench_stream_bandwidth ();
+
+  printf ("matvec %s bytes=%.0f GB/s=%.2f stream_GB/s=%.2f stream_ratio=%.2f\n",
+	  kernel, bytes, gbs, stream, stream > 0 ? gbs / stream : 0);
+}
+
+# endif /* POLYBENCH_MATVEC_REPORT */
+
+#endif /* !POLYBENCH_MATVEC_H */
@@ -0,0 +1,166 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/*
+ * polybench_steal.h: this file is part of PolyBench/C
+ *
+ * Work-stealing scheduler of the parallel kernel variants, over the
+ * tiles of their output arrays. Tiles are numbered 0 to n-1 and dealt
+ * out as one contiguous range per thread; a thread runs its own range
+ * from the low end, and once it is empty steals the upper half of the
+ * range of another thread, so that threads left with cheap (edge) tiles
+ * help those with expensive ones.
+ *
+ * Build with -fopenmp; without OpenMP the calling thread runs every
+ * tile. -DPOLYBENCH_THREADS=N sets the number of threads.
+ *
+ * Usage:
+ *   polybench_steal_init (&pool);
+ *   #pragma omp parallel
+ *   {
+ *     #pragma omp single
+ *     polybench_steal_fill (&pool, nb_tiles);
+ *     while (polybench_steal_next (&pool, &tile))
+ *       ...
+ *   }
+ *   polybench_steal_free (&pool);
+ *
+ * A barrier is needed before refilling the pool in the same parallel
+ * region.
+ */
+#ifndef POLYBENCH_STEAL_H
+# define POLYBENCH_STEAL_H
+
+# include <stdlib.h>
+# ifdef _OPENMP
+#  include <omp.h>
+# endif
+
+/* Range [lo, hi) of a thread, packed in a single word so that the owner
+   taking lo and a thief taking the upper half race on one
+   compare-and-swap. One cache line per thread. */
+typedef struct
+{
+  unsigned long long range;
+  char pad[64 - sizeof (unsigned long long)];
+} polybench_steal_queue_t;
+
+typedef struct
+{
+  polybench_steal_queue_t* queues;
+  int nb_queues;
+} polybench_steal_pool_t;
+
+# define POLYBENCH_STEAL_PACK(lo, hi) \
+  (((unsigned long long) (hi) << 32) | (unsigned long long) (lo))
+# define POLYBENCH_STEAL_LO(r) ((unsigned) ((r) & 0xffffffffULL))
+# define POLYBENCH_STEAL_HI(r) ((unsigned) ((r) >> 32))
+
+
+static
+void polybench_steal_init (polybench_steal_pool_t* pool)
+{
+  void* ptr = NULL;
+  int n = 1;
+
+# ifdef _OPENMP
+#  ifdef POLYBENCH_THREADS
+  omp_set_num_threads (POLYBENCH_THREADS);
+#  endif
+  n = omp_get_max_threads ();
+# endif
+  if (posix_memalign (&ptr, 64, n * sizeof (polybench_steal_queue_t)))
+    abort ();
+  pool->queues = (polybench_steal_queue_t*) ptr;
+  pool->nb_queues = n;
+}
+
+
+static
+void polybench_steal_free (polybench_steal_pool_t* pool)
+{
+  free (pool->queues);
+  pool->queues = NULL;
+}
+
+
+/* Deals tiles 0 to nb_tiles-1 out. By a single thread, while no other
+   one takes tiles. */
+static
+void polybench_steal_fill (polybench_steal_pool_t* pool, int nb_tiles)
+{
+  int q;
+  long n = nb_tiles > 0 ? nb_tiles : 0;
+
+  for (q = 0; q < pool->nb_queues; q++)
+    __atomic_store_n (&pool->queues[q].range,
+		      POLYBENCH_STEAL_PACK (n * q / pool->nb_queues,
+					    n * (q + 1) / pool->nb_queues),
+		      __ATOMIC_RELEASE);
+}
+
+
+static
+int polybench_steal_self (void)
+{
+# ifdef _OPENMP
+  return omp_get_thread_num ();
+# else
+  return 0;
+# endif
+}
+
+
+/* Next tile of the calling thread. Returns 0 once every range is
+   empty. */
+static
+int polybench_steal_next (polybench_steal_pool_t* pool, int* tile)
+{
+  int self = polybench_steal_self () % pool->nb_queues;
+  polybench_steal_queue_t* own = &pool->queues[self];
+  unsigned long long r = __atomic_load_n (&own->range, __ATOMIC_ACQUIRE);
+  int v;
+
+  /* Own range, from the low end. */
+  while (POLYBENCH_STEAL_LO (r) < POLYBENCH_STEAL_HI (r))
+    if (__atomic_compare_exchange_n (&own->range, &r,
+				     POLYBENCH_STEAL_PACK (POLYBENCH_STEAL_LO (r) + 1,
+							   POLYBENCH_STEAL_HI (r)),
+				     0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      {
+	*tile = (int) POLYBENCH_STEAL_LO (r);
+	return 1;
+      }
+
+  /* Upper half of another range: run its first tile, keep the rest. */
+  for (v = 1; v < pool->nb_queues; v++)
+    {
+      polybench_steal_queue_t* victim =
+	&pool->queues[(self + v) % pool->nb_queues];
+      unsigned long long vr = __atomic_load_n (&victim->range, __ATOMIC_ACQUIRE);
+      while (POLYBENCH_STEAL_LO (vr) < POLYBENCH_STEAL_HI (vr))
+	{
+	  unsigned lo = POLYBENCH_STEAL_LO (vr);
+	  unsigned hi = POLYBENCH_STEAL_HI (vr);
+	  unsigned mid = lo + (hi - lo) / 2;
+	  if (__atomic_compare_exchange_n (&victim->range, &vr,
+					   POLYBENCH_STEAL_PACK (lo, mid),
+					   0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+	    {
+	      __atomic_store_n (&own->range, POLYBENCH_STEAL_PACK (mid + 1, hi),
+				__ATOMIC_RELEASE);
+	      *tile = (int) mid;
+	      return 1;
+	    }
+	}
+    }
+  return 0;
+}
+
+#endif /* !POLYBENCH_STEAL_H */
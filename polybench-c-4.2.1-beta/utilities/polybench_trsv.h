@@ -0,0 +1,353 @@
+/**
+ * This version is stamped on May 10, 2016
+ *
+ * Contact:
+ *   Louis-Noel Pouchet <pouchet.ohio-state.edu>
+ *   Tomofumi Yuki <tomofumi.yuki.fr>
+ *
+ * Web address: http://polybench.sourceforge.net
+ */
+/*
+ * polybench_trsv.h: this file is part of PolyBench/C
+ *
+ * Blocked triangular solves of the solver kernels (trisolv, and the
+ * forward and back substitutions of ludcmp), in place. Include after the
+ * kernel header, as it uses DATA_TYPE.
+ *
+ * The unknowns are cut into blocks of TRSV_NB rows, solved from the top
+ * (lower triangular) or from the bottom (upper triangular). Each step
+ * subtracts from the rows of the block the contributions of the unknowns
+ * solved before, a matrix-vector product with the off-diagonal part of
+ * the block rows, then solves the diagonal block. The product is split
+ * between OpenMP threads, TRSV_ROWS rows at a time with one SIMD
+ * accumulator per row, and streams the rows of the matrix like the
+ * reference loops; these instead chain the additions of a single dot
+ * product, which the compiler may not reorder. Several right-hand sides
+ * can be solved at once, the triangular matrix then being read once for
+ * all of them.
+ *
+ * With POLYBENCH_TRSV_CROSSOVER, polybench_trsv_crossover times the
+ * row-oriented and blocked solves on the leading submatrices of a lower
+ * triangular matrix, to find the size from which blocking pays off. It is
+ * an offline experiment, repeating each solve many times, and is left out
+ * of the timed runs.
+ */
+#ifndef POLYBENCH_TRSV_H
+# define POLYBENCH_TRSV_H
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <time.h>
+# ifdef _OPENMP
+#  include <omp.h>
+# endif
+
+/* Rows of a block. */
+# ifndef TRSV_NB
+#  define TRSV_NB 128
+# endif
+/* Rows of a step of the matrix-vector product (one accumulator each). */
+# define TRSV_ROWS 4
+/* Right-hand sides of a step of the product, when there are several. */
+# define TRSV_RHS 8
+/* Right-hand sides of the batched solve of polybench_trsv_crossover. */
+# ifndef TRSV_BATCH
+#  define TRSV_BATCH 8
+# endif
+
+/* Size of block i of n rows. */
+# define TRSV_TILE(i, n) \
+  ((i) * TRSV_NB + TRSV_NB < (n) ? TRSV_NB : (n) - (i) * TRSV_NB)
+
+
+/* Solves the nb x nb diagonal block T for the rows of X, which already
+   hold the right-hand sides minus the contributions of the other blocks. */
+static
+void polybench_trsv_diag (int nb, int upper, int unit,
+			  const DATA_TYPE* T, int ldt,
+			  DATA_TYPE* X, int ldx, int nrhs)
+{
+  int s, i, j, c;
+
+  for (s = 0; s < nb; s++)
+    {
+      const DATA_TYPE* t;
+      DATA_TYPE* xi;
+      int j0, j1;
+
+      i = upper ? nb - 1 - s : s;
+      t = T + (long) i * ldt;
+      xi = X + (long) i * ldx;
+      j0 = upper ? i + 1 : 0;
+      j1 = upper ? nb : i;
+      if (nrhs == 1)
+	{
+	  DATA_TYPE w = 0;
+#pragma omp simd reduction(+:w)
+	  for (j = j0; j < j1; j++)
+	    w += t[j] * X[j];
+	  xi[0] = xi[0] - w;
+	  if (!unit)
+	    xi[0] = xi[0] / t[i];
+	  continue;
+	}
+      for (j = j0; j < j1; j++)
+	{
+	  DATA_TYPE a = t[j];
+	  const DATA_TYPE* xj = X + (long) j * ldx;
+#pragma omp simd
+	  for (c = 0; c < nrhs; c++)
+	    xi[c] -= a * xj[c];
+	}
+      if (!unit)
+	for (c = 0; c < nrhs; c++)
+	  xi[c] = xi[c] / t[i];
+    }
+}
+
+
+/* X[0:m] -= T[0:m][0:nb] * Xs[0:nb], m at most TRSV_ROWS. */
+static POLYBENCH_ISA_CLONES
+void polybench_trsv_update (int m, int nb,
+			    const DATA_TYPE* POLYBENCH_RESTRICT T, int ldt,
+			    const DATA_TYPE* POLYBENCH_RESTRICT Xs,
+			    DATA_TYPE* POLYBENCH_RESTRICT X, int ldx, int nrhs)
+{
+  const DATA_TYPE* t0 = T;
+  const DATA_TYPE* t1 = t0 + ldt;
+  const DATA_TYPE* t2 = t1 + ldt;
+  const DATA_TYPE* t3 = t2 + ldt;
+  int r, j, c, c0 = 0;
+
+  if (m == TRSV_ROWS && nrhs == 1)
+    {
+      DATA_TYPE s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+#pragma omp simd reduction(+:s0,s1,s2,s3)
+      for (j = 0; j < nb; j++)
+	{
+	  s0 += t0[j] * Xs[j];
+	  s1 += t1[j] * Xs[j];
+	  s2 += t2[j] * Xs[j];
+	  s3 += t3[j] * Xs[j];
+	}
+      X[0] -= s0;
+      X[1] -= s1;
+      X[2] -= s2;
+      X[3] -= s3;
+      return;
+    }
+  /* several right-hand sides: TRSV_RHS of them at a time, with a
+     TRSV_ROWS x TRSV_RHS block of accumulators */
+  if (m == TRSV_ROWS)
+    for (; c0 + TRSV_RHS <= nrhs; c0 += TRSV_RHS)
+      {
+	DATA_TYPE s0[TRSV_RHS], s1[TRSV_RHS], s2[TRSV_RHS], s3[TRSV_RHS];
+	for (c = 0; c < TRSV_RHS; c++)
+	  s0[c] = s1[c] = s2[c] = s3[c] = 0;
+	for (j = 0; j < nb; j++)
+	  {
+	    const DATA_TYPE* xj = Xs + (long) j * ldx + c0;
+#pragma omp simd
+	    for (c = 0; c < TRSV_RHS; c++)
+	      {
+		s0[c] += t0[j] * xj[c];
+		s1[c] += t1[j] * xj[c];
+		s2[c] += t2[j] * xj[c];
+		s3[c] += t3[j] * xj[c];
+	      }
+	  }
+	for (c = 0; c < TRSV_RHS; c++)
+	  {
+	    X[c0 + c] -= s0[c];
+	    X[ldx + c0 + c] -= s1[c];
+	    X[2 * ldx + c0 + c] -= s2[c];
+	    X[3 * ldx + c0 + c] -= s3[c];
+	  }
+      }
+  /* remaining rows and right-hand sides */
+  for (r = 0; r < m; r++)
+    {
+      const DATA_TYPE* t = T + (long) r * ldt;
+      DATA_TYPE* xr = X + (long) r * ldx;
+      if (nrhs == 1)
+	{
+	  DATA_TYPE w = 0;
+#pragma omp simd reduction(+:w)
+	  for (j = 0; j < nb; j++)
+	    w += t[j] * Xs[j];
+	  xr[0] -= w;
+	  continue;
+	}
+      for (j = 0; j < nb; j++)
+	{
+	  DATA_TYPE a = t[j];
+	  const DATA_TYPE* xj = Xs + (long) j * ldx;
+#pragma omp simd
+	  for (c = c0; c < nrhs; c++)
+	    xr[c] -= a * xj[c];
+	}
+    }
+}
+
+
+/* Solves T X = B in place, T being the n x n lower (or upper) triangle
+   of a matrix with rows ldt elements apart, with a unit diagonal when
+   unit. X holds B on entry: n rows of nrhs right-hand sides, ldx elements
+   apart (ldx is ignored for a single right-hand side). */
+static
+void polybench_trsv (int n, int upper, int unit,
+		     const DATA_TYPE* T, int ldt,
+		     DATA_TYPE* X, int ldx, int nrhs)
+{
+  const int nt = (n + TRSV_NB - 1) / TRSV_NB;
+
+  if (nrhs == 1)
+    ldx = 1;
+# if defined(_OPENMP) && defined(POLYBENCH_THREADS)
+  omp_set_num_threads (POLYBENCH_THREADS);
+# endif
+#pragma omp parallel if (n > TRSV_NB)
+  {
+    int s, g;
+    for (s = 0; s < nt; s++)
+      {
+	const int kb = upper ? nt - 1 - s : s;
+	const int k0 = kb * TRSV_NB;
+	const int kn = TRSV_TILE (kb, n);
+	/* columns of the unknowns solved before */
+	const int c0 = upper ? k0 + kn : 0;
+	const int c1 = upper ? n : k0;
+	const int groups = (kn + TRSV_ROWS - 1) / TRSV_ROWS;
+
+#pragma omp for schedule(static)
+	for (g = 0; g < groups; g++)
+	  {
+	    int i0 = k0 + g * TRSV_ROWS;
+	    int i1 = i0 + TRSV_ROWS < k0 + kn ? i0 + TRSV_ROWS : k0 + kn;
+	    polybench_trsv_update (i1 - i0, c1 - c0, T + (long) i0 * ldt + c0,
+				   ldt, X + (long) c0 * ldx, X + (long) i0 * ldx,
+				   ldx, nrhs);
+	  }
+#pragma omp single
+	polybench_trsv_diag (kn, upper, unit, T + (long) k0 * ldt + k0, ldt,
+			     X + (long) k0 * ldx, ldx, nrhs);
+      }
+  }
+}
+
+# ifdef POLYBENCH_TRSV_CROSSOVER
+
+static
+double polybench_trsv_clock (void)
+{
+  struct timespec ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+/* Row-oriented forward substitution of trisolv. */
+static
+void polybench_trsv_reference (int n, const DATA_TYPE* L, int ldl,
+			       const DATA_TYPE* b, DATA_TYPE* x)
+{
+  int i, j;
+
+  for (i = 0; i < n; i++)
+    {
+      x[i] = b[i];
+      for (j = 0; j < i; j++)
+	x[i] -= L[(long) i * ldl + j] * x[j];
+      x[i] = x[i] / L[(long) i * ldl + i];
+    }
+}
+
+
+/* Best time of a call of the row-oriented (blocked = 0), blocked
+   (blocked = 1) or batched (blocked = 2, TRSV_BATCH right-hand sides at
+   once) solve of the leading m x m submatrix of L. */
+static
+double polybench_trsv_time (int m, int blocked, const DATA_TYPE* L, int ldl,
+			    const DATA_TYPE* b, DATA_TYPE* x)
+{
+  /* about 2^24 multiply-adds per measure */
+  const long reps = 1 + (1L << 25) / ((long) m * m);
+  double best = 0;
+  long r;
+  int k, i;
+
+  for (k = 0; k < 3; k++)
+    {
+      double t = polybench_trsv_clock ();
+      for (r = 0; r < reps; r++)
+	if (blocked == 0)
+	  polybench_trsv_reference (m, L, ldl, b, x);
+	else if (blocked == 1)
+	  {
+	    for (i = 0; i < m; i++)
+	      x[i] = b[i];
+	    polybench_trsv (m, 0, 0, L, ldl, x, 1, 1);
+	  }
+	else
+	  {
+	    for (i = 0; i < m * TRSV_BATCH; i++)
+	      x[i] = b[i / TRSV_BATCH];
+	    polybench_trsv (m, 0, 0, L, ldl, x, TRSV_BATCH, TRSV_BATCH);
+	  }
+      t = (polybench_trsv_clock () - t) / reps;
+      if (best == 0 || t < best)
+	best = t;
+    }
+  return best;
+}
+
+
+/* Times the row-oriented and the blocked solves of the leading
+   submatrices of L (lower triangular, n x n, rows ldl elements apart),
+   from 16 rows to n, and prints the smallest size from which the blocked
+   solve is faster at every size, then the time of TRSV_BATCH solves of
+   size n against a single batched solve. */
+static inline
+void polybench_trsv_crossover (int n, const DATA_TYPE* L, int ldl)
+{
+  DATA_TYPE* b = (DATA_TYPE*) malloc ((long) n * sizeof (DATA_TYPE));
+  DATA_TYPE* x = (DATA_TYPE*) malloc ((long) n * TRSV_BATCH
+				      * sizeof (DATA_TYPE));
+  int crossover = 0;
+  int m, i;
+
+  if (b == NULL || x == NULL)
+    abort ();
+  for (i = 0; i < n; i++)
+    b[i] = i;
+  for (m = 16; ; m = 2 * m < n ? 2 * m : n)
+    {
+      double tr = polybench_trsv_time (m, 0, L, ldl, b, x);
+      double tb = polybench_trsv_time (m, 1, L, ldl, b, x);
+      printf ("trsv n=%d reference_s=%.3g blocked_s=%.3g speedup=%.2f\n",
+	      m, tr, tb, tb > 0 ? tr / tb : 0);
+      if (tb >= tr)
+	crossover = 0;
+      else if (crossover == 0)
+	crossover = m;
+      if (m >= n)
+	break;
+    }
+  if (crossover)
+    printf ("trsv crossover_n=%d\n", crossover);
+  else
+    printf ("trsv crossover_n=none\n");
+  {
+    double ts = TRSV_BATCH * polybench_trsv_time (n, 1, L, ldl, b, x);
+    double tb = polybench_trsv_time (n, 2, L, ldl, b, x);
+    printf ("trsv batch n=%d nrhs=%d single_s=%.3g batched_s=%.3g speedup=%.2f\n",
+	    n, TRSV_BATCH, ts, tb, tb > 0 ? ts / tb : 0);
+  }
+  free (b);
+  free (x);
+}
+
+# endif /* POLYBENCH_TRSV_CROSSOVER */
+
+#endif /* !POLYBENCH_TRSV_H */
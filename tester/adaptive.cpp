@@ -0,0 +1,165 @@
+#include "adaptive.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+AdaptiveKernel::AdaptiveKernel(const run_element_t &baseline,
+                               const std::vector<std::string> &candidate_flags,
+                               const run_config_t &cfg,
+                               unsigned int samples)
+    : _baseline(baseline), _candidate_flags(candidate_flags), _cfg(cfg),
+      _samples(std::max(samples, 2u)), _current(nullptr), _swaps(0),
+      _evaluating(nullptr), _turn(false), _stop(false) {}
+
+AdaptiveKernel::~AdaptiveKernel() {
+	_stop = true;
+	if (_compiler.joinable()) {
+		_compiler.join();
+	}
+	for (auto it = _versions.begin(); it != _versions.end(); ++it) {
+		if (get_arena(_cfg, _baseline) && it->sym.set_arena) {
+			it->sym.set_arena(nullptr, 0);
+		}
+		// the baseline belongs to the sweep, candidates to us
+		if (it != _versions.begin()) {
+			it->version->fold();
+		}
+	}
+}
+
+bool AdaptiveKernel::start() {
+	if (!_cfg.compile_cpus.empty()) {
+		pin_current_thread(_cfg.compile_cpus);
+	}
+	candidate_t base;
+	base.label = "baseline";
+	base.version = _baseline.version;
+	if (!base.version->compile() || !load_runner_symbols(*base.version, base.sym)) {
+		std::cerr << "Error while compiling " << _baseline.label << std::endl;
+		return false;
+	}
+	_versions.push_back(base);
+	_current = &_versions.front();
+	_compiler = std::thread(&AdaptiveKernel::compile_candidates, this);
+	return true;
+}
+
+void AdaptiveKernel::compile_candidates() {
+	if (!_cfg.compile_cpus.empty()) {
+		pin_current_thread(_cfg.compile_cpus);
+	}
+	for (const auto &flags : _candidate_flags) {
+		if (_stop) {
+			return;
+		}
+		candidate_t c;
+		c.label = flags;
+		c.version = make_variant(_baseline, flags).version;
+		if (!c.version->compile() || !load_runner_symbols(*c.version, c.sym)) {
+			std::cerr << "Error while compiling " << _baseline.label << " with "
+			          << flags << std::endl;
+			continue;
+		}
+		std::lock_guard<std::mutex> lock(_mtx);
+		_versions.push_back(c);
+		_ready.push_back(&_versions.back());
+	}
+}
+
+double AdaptiveKernel::call() {
+	candidate_t *current = _current.load();
+	candidate_t *target = current;
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		if (!_evaluating && !_ready.empty()) {
+			// compare on calls interleaved with the candidate only
+			_evaluating = _ready.front();
+			_ready.pop_front();
+			current->samples.clear();
+			_turn = true;
+		}
+		if (_evaluating && _turn) {
+			target = _evaluating;
+		}
+		_turn = !_turn;
+	}
+
+	char* runningArgv[] = { nullptr };
+	const Arena *arena = get_arena(_cfg, _baseline);
+	if (arena && target->sym.set_arena) {
+		target->sym.set_arena(arena->data(), arena->size());
+	}
+	if (!_cfg.run_cpus.empty()) {
+		pin_current_thread(_cfg.run_cpus);
+	}
+	target->sym.run(0, runningArgv);
+	if (!_cfg.compile_cpus.empty()) {
+		pin_current_thread(_cfg.compile_cpus);
+	}
+	const double elapsed = target->sym.elapsed ? target->sym.elapsed() : 0;
+
+	std::lock_guard<std::mutex> lock(_mtx);
+	target->samples.push_back(elapsed);
+	if (!_evaluating) {
+		if (current->samples.size() > _samples) {
+			current->samples.erase(current->samples.begin());
+		}
+		return elapsed;
+	}
+	if (_evaluating->samples.size() >= _samples && current->samples.size() >= _samples) {
+		if (median(_evaluating->samples) < median(current->samples) &&
+		    mann_whitney_p(current->samples, _evaluating->samples) < 0.05) {
+			_current.store(_evaluating);
+			_swaps++;
+		}
+		_evaluating = nullptr;
+	}
+	return elapsed;
+}
+
+std::string AdaptiveKernel::current_label() const {
+	const candidate_t *current = _current.load();
+	return current ? current->label : "";
+}
+
+size_t run_adaptive(JobGenerator &jobs,
+                    const harness_options_t &opts,
+                    const run_config_t &cfg,
+                    const result_handler_t &on_result) {
+	size_t failed = 0;
+	run_element_t j;
+	while (jobs.next(j)) {
+		std::cout << "adaptive " << j.label << std::endl;
+		run_result_t r = run_result_t();
+		r.placement.last_cpu = -1;
+		r.usage.rss_peak_kb = -1;
+		{
+			AdaptiveKernel kernel(j, opts.adaptive_flags, cfg, std::max(opts.trials, 5u));
+			r.ok = kernel.start();
+			std::string label = kernel.current_label();
+			for (unsigned int c = 0; r.ok && c < opts.adaptive_calls; c++) {
+				r.trials.push_back(kernel.call());
+				if (kernel.current_label() != label) {
+					label = kernel.current_label();
+					std::cout << "adaptive swap to " << label << " after call " << c + 1
+					          << std::endl;
+				}
+			}
+			if (r.ok) {
+				r.elapsed = median(r.trials);
+				r.placement = get_current_placement();
+				std::cout << "adaptive settled on " << label << " after "
+				          << kernel.swaps() << " swaps: first call " << r.trials.front()
+				          << " s, last call " << r.trials.back() << " s" << std::endl;
+			}
+		}
+		if (!r.ok) {
+			failed++;
+		}
+		if (on_result) {
+			on_result(j, r);
+		}
+	}
+	return failed;
+}
@@ -0,0 +1,79 @@
+#ifndef _ADAPTIVE_HPP_
+#define _ADAPTIVE_HPP_
+
+#include "options.hpp"
+#include "runner.hpp"
+#include "sweep.hpp"
+
+#include <atomic>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Adaptive execution of one kernel. Calls are dispatched through an atomic
+// pointer to the current version, which starts as the cheap baseline job.
+// Candidates (the baseline rebuilt with extra flags) are compiled by a
+// background thread; each one is then benchmarked on live calls,
+// interleaved with calls to the current version, and swapped in when it is
+// significantly faster. Reading the dispatch pointer is lock free; calls
+// themselves are serialized, as PolyBench keeps its timer in globals.
+// Replaced versions stay loaded until destruction.
+class AdaptiveKernel {
+ public:
+	// samples: calls of each side before deciding on a candidate
+	AdaptiveKernel(const run_element_t &baseline,
+	               const std::vector<std::string> &candidate_flags,
+	               const run_config_t &cfg,
+	               unsigned int samples);
+	~AdaptiveKernel();
+	AdaptiveKernel(const AdaptiveKernel &) = delete;
+	AdaptiveKernel &operator=(const AdaptiveKernel &) = delete;
+
+	// compiles the baseline and starts the background compilation
+	bool start();
+	// one live call, returns its elapsed time
+	double call();
+
+	std::string current_label() const;
+	// versions swapped in so far
+	unsigned int swaps() const { return _swaps; }
+
+ private:
+	typedef struct ac_t {
+		std::string label;                     // extra flags, "baseline" first
+		std::shared_ptr<vc::Version> version;
+		runner_symbols_t sym;
+		std::vector<double> samples;           // latest calls of the version
+	} candidate_t;
+
+	void compile_candidates();
+
+	const run_element_t _baseline;
+	const std::vector<std::string> _candidate_flags;
+	const run_config_t _cfg;
+	const unsigned int _samples;
+
+	std::list<candidate_t> _versions;          // stable addresses
+	std::atomic<candidate_t*> _current;
+	std::atomic<unsigned int> _swaps;
+	mutable std::mutex _mtx;
+	std::deque<candidate_t*> _ready;           // compiled, not evaluated yet
+	candidate_t *_evaluating;
+	bool _turn;                                // next call goes to the candidate
+	std::thread _compiler;
+	std::atomic<bool> _stop;
+};
+
+// Calls each version of jobs opts.adaptive_calls times through an
+// AdaptiveKernel whose candidates are built with opts.adaptive_flags.
+// The results passed to on_result hold the time of every call.
+// Returns the number of failures.
+size_t run_adaptive(JobGenerator &jobs,
+                    const harness_options_t &opts,
+                    const run_config_t &cfg,
+                    const result_handler_t &on_result = nullptr);
+
+#endif /* end of include guard: _ADAPTIVE_HPP_ */
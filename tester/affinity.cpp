@@ -0,0 +1,195 @@
+#include "affinity.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdlib.h>
+#include <sched.h>
+
+bool parse_cpu_list(const std::string &text, cpu_list_t &cpus) {
+	cpus.clear();
+	std::stringstream ss(text);
+	std::string range;
+	while (std::getline(ss, range, ',')) {
+		if (range.empty()) {
+			continue;
+		}
+		// both bounds of a range are required: "-" or "3-" are errors
+		char *end = nullptr;
+		const long first = strtol(range.c_str(), &end, 10);
+		bool valid = end != range.c_str();
+		long last = first;
+		if (*end == '-') {
+			const char *bound = end + 1;
+			last = strtol(bound, &end, 10);
+			valid = valid && end != bound;
+		}
+		if (!valid || *end != '\0' || first < 0 || last < first || last >= CPU_SETSIZE) {
+			return false;
+		}
+		for (long c = first; c <= last; c++) {
+			cpus.push_back(static_cast<int>(c));
+		}
+	}
+	std::sort(cpus.begin(), cpus.end());
+	cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+	return !cpus.empty();
+}
+
+std::string format_cpu_list(const cpu_list_t &cpus) {
+	std::string res;
+	for (size_t i = 0; i < cpus.size(); i++) {
+		size_t j = i;
+		while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+			j++;
+		}
+		if (!res.empty()) {
+			res += ",";
+		}
+		res += std::to_string(cpus[i]);
+		if (j != i) {
+			res += "-" + std::to_string(cpus[j]);
+		}
+		i = j;
+	}
+	return res.empty() ? "-" : res;
+}
+
+cpu_list_t get_thread_affinity() {
+	cpu_list_t cpus;
+	cpu_set_t mask;
+	CPU_ZERO(&mask);
+	if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+		for (int c = 0; c < CPU_SETSIZE; c++) {
+			if (CPU_ISSET(c, &mask)) {
+				cpus.push_back(c);
+			}
+		}
+	}
+	return cpus;
+}
+
+bool pin_current_thread(const cpu_list_t &cpus) {
+	if (cpus.empty()) {
+		return false;
+	}
+	cpu_set_t mask;
+	CPU_ZERO(&mask);
+	for (const int c : cpus) {
+		CPU_SET(c, &mask);
+	}
+	// pid 0 is the calling thread, not the whole process
+	return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+}
+
+cpu_list_t cpu_list_difference(const cpu_list_t &from, const cpu_list_t &what) {
+	cpu_list_t res;
+	for (const int c : from) {
+		if (std::find(what.begin(), what.end(), c) == what.end()) {
+			res.push_back(c);
+		}
+	}
+	return res;
+}
+
+bool cpu_list_contains(const cpu_list_t &set, const cpu_list_t &what) {
+	if (what.empty()) {
+		return false;
+	}
+	for (const int c : what) {
+		if (std::find(set.begin(), set.end(), c) == set.end()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static cpu_list_t read_sysfs_cpu_list(const std::string &path) {
+	cpu_list_t cpus;
+	std::ifstream in(path);
+	std::string line;
+	if (in && std::getline(in, line)) {
+		parse_cpu_list(line, cpus);
+	}
+	return cpus;
+}
+
+cpu_list_t get_isolated_cpus() {
+	return read_sysfs_cpu_list("/sys/devices/system/cpu/isolated");
+}
+
+cpu_list_t get_nohz_full_cpus() {
+	return read_sysfs_cpu_list("/sys/devices/system/cpu/nohz_full");
+}
+
+// cpus sharing the highest cache level of cpu (just cpu when unknown)
+static cpu_list_t get_llc_siblings(int cpu) {
+	const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cache/";
+	int best_level = 0;
+	cpu_list_t siblings = { cpu };
+	for (int index = 0; ; index++) {
+		std::ifstream level_file(base + "index" + std::to_string(index) + "/level");
+		int level = 0;
+		if (!(level_file >> level)) {
+			break;
+		}
+		if (level > best_level) {
+			cpu_list_t shared = read_sysfs_cpu_list(base + "index" + std::to_string(index) +
+			                                        "/shared_cpu_list");
+			if (!shared.empty()) {
+				best_level = level;
+				siblings = shared;
+			}
+		}
+	}
+	return siblings;
+}
+
+std::vector<cpu_list_t> get_llc_groups(const cpu_list_t &cpus) {
+	std::vector<cpu_list_t> groups;
+	cpu_list_t assigned;
+	for (const int c : cpus) {
+		if (std::find(assigned.begin(), assigned.end(), c) != assigned.end()) {
+			continue;
+		}
+		cpu_list_t group;
+		for (const int s : get_llc_siblings(c)) {
+			if (std::find(cpus.begin(), cpus.end(), s) != cpus.end()) {
+				group.push_back(s);
+			}
+		}
+		if (std::find(group.begin(), group.end(), c) == group.end()) {
+			group.push_back(c);
+			std::sort(group.begin(), group.end());
+		}
+		assigned.insert(assigned.end(), group.begin(), group.end());
+		groups.push_back(group);
+	}
+	return groups;
+}
+
+void set_openmp_placement(const cpu_list_t &cpus) {
+	std::string places;
+	for (const int c : cpus) {
+		places += (places.empty() ? "{" : ",{") + std::to_string(c) + "}";
+	}
+	setenv("OMP_PLACES", places.c_str(), 0);
+	setenv("OMP_PROC_BIND", "close", 0);
+	setenv("OMP_NUM_THREADS", std::to_string(cpus.size()).c_str(), 0);
+}
+
+placement_t get_current_placement() {
+	placement_t p;
+	p.cpus = get_thread_affinity();
+	p.last_cpu = sched_getcpu();
+	p.isolated = cpu_list_contains(get_isolated_cpus(), p.cpus);
+	p.nohz_full = cpu_list_contains(get_nohz_full_cpus(), p.cpus);
+	return p;
+}
+
+std::string describe_placement(const placement_t &p) {
+	return "cpus=" + format_cpu_list(p.cpus) +
+	       " last_cpu=" + std::to_string(p.last_cpu) +
+	       " isolated=" + (p.isolated ? "yes" : "no") +
+	       " nohz_full=" + (p.nohz_full ? "yes" : "no");
+}
@@ -0,0 +1,53 @@
+#ifndef _AFFINITY_HPP_
+#define _AFFINITY_HPP_
+
+#include <string>
+#include <vector>
+
+// ordered set of logical cpu ids, as in "0-3,8"
+typedef std::vector<int> cpu_list_t;
+
+// where a measurement actually ran
+typedef struct pl_t {
+	cpu_list_t cpus;     // affinity mask of the measurement thread
+	int last_cpu;        // cpu the thread was on when the kernel returned
+	bool isolated;       // every cpu in the mask is listed in isolcpus
+	bool nohz_full;      // every cpu in the mask is listed in nohz_full
+} placement_t;
+
+// parse a kernel-style cpu list ("0-3,8,10-11"). Returns false on error.
+bool parse_cpu_list(const std::string &text, cpu_list_t &cpus);
+
+// inverse of parse_cpu_list, ranges are collapsed
+std::string format_cpu_list(const cpu_list_t &cpus);
+
+// cpus the calling thread is allowed to run on
+cpu_list_t get_thread_affinity();
+
+// restrict the calling thread (and the processes it spawns) to cpus
+bool pin_current_thread(const cpu_list_t &cpus);
+
+// elements of from which are not in what
+cpu_list_t cpu_list_difference(const cpu_list_t &from, const cpu_list_t &what);
+
+// true when every cpu of what is in set
+bool cpu_list_contains(const cpu_list_t &set, const cpu_list_t &what);
+
+// cpus listed by the kernel as isolated (isolcpus=) and tickless (nohz_full=)
+cpu_list_t get_isolated_cpus();
+cpu_list_t get_nohz_full_cpus();
+
+// partition of cpus by shared last level cache, in ascending cpu order.
+// Without cache topology information every cpu is a group on its own.
+std::vector<cpu_list_t> get_llc_groups(const cpu_list_t &cpus);
+
+// export OMP_PLACES/OMP_PROC_BIND/OMP_NUM_THREADS so that OpenMP teams
+// spawned by the kernels stay on cpus. User-provided values win.
+void set_openmp_placement(const cpu_list_t &cpus);
+
+// snapshot of the calling thread placement
+placement_t get_current_placement();
+
+std::string describe_placement(const placement_t &p);
+
+#endif /* end of include guard: _AFFINITY_HPP_ */
@@ -0,0 +1,132 @@
+#include "arena.hpp"
+#include "affinity.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+static const size_t huge_page_2mb = 2UL << 20;
+static const size_t huge_page_1gb = 1UL << 30;
+
+static size_t round_up(size_t size, size_t granularity) {
+	return (size + granularity - 1) / granularity * granularity;
+}
+
+// hugetlb pages of 1 << shift bytes, nullptr when none is reserved
+static void *map_hugetlb(size_t size, int shift) {
+	void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+	               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (shift << MAP_HUGE_SHIFT),
+	               -1, 0);
+	return p == MAP_FAILED ? nullptr : p;
+}
+
+// regular pages, 2MB aligned for transparent huge pages as in polybench.c
+static void *map_pages(size_t size, bool huge_pages) {
+	const size_t align = huge_pages ? huge_page_2mb : 0;
+	char *raw = static_cast<char *>(mmap(nullptr, size + align, PROT_READ | PROT_WRITE,
+	                                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+	                                     -1, 0));
+	if (raw == MAP_FAILED) {
+		return nullptr;
+	}
+	char *p = raw;
+	if (huge_pages) {
+		p = reinterpret_cast<char *>(round_up(reinterpret_cast<size_t>(raw), align));
+		if (p != raw) {
+			munmap(raw, p - raw);
+		}
+		if (p + size != raw + size + align) {
+			munmap(p + size, (raw + size + align) - (p + size));
+		}
+		madvise(p, size, MADV_HUGEPAGE);
+	}
+	return p;
+}
+
+// nodes with memory as listed by the kernel, node 0 alone when unknown
+static unsigned long get_memory_nodes() {
+	std::ifstream in("/sys/devices/system/node/has_memory");
+	std::string text;
+	cpu_list_t nodes;
+	unsigned long mask = 0;
+	if (std::getline(in, text) && parse_cpu_list(text, nodes)) {
+		for (const int n : nodes) {
+			if (n < static_cast<int>(8 * sizeof(mask))) {
+				mask |= 1UL << n;
+			}
+		}
+	}
+	return mask ? mask : 1UL;
+}
+
+// the NUMA policy of polybench.c, before any page is faulted in
+static void place(void *p, size_t size, const std::string &numa_policy, int numa_node) {
+	unsigned long nodemask = 0;
+	int mode;
+	if (numa_policy == "local") {
+		// preferred with an empty mask means local allocation
+		mode = MPOL_PREFERRED;
+	} else if (numa_policy == "interleave") {
+		mode = MPOL_INTERLEAVE;
+		nodemask = get_memory_nodes();
+	} else if (numa_policy == "bind") {
+		mode = MPOL_BIND;
+		nodemask = 1UL << numa_node;
+	} else {
+		return;
+	}
+	if (syscall(SYS_mbind, p, size, mode, nodemask ? &nodemask : nullptr,
+	            nodemask ? 8 * sizeof(nodemask) + 1 : 0, 0) != 0) {
+		std::cerr << "Warning: NUMA policy " << numa_policy
+		          << " not applied to the arena" << std::endl;
+	}
+}
+
+Arena::Arena(size_t size, const std::string &hugepages,
+             const std::string &numa_policy, int numa_node)
+    : _data(nullptr), _size(0) {
+	void *p = nullptr;
+	if (hugepages == "1gb") {
+		_size = round_up(size, huge_page_1gb);
+		p = map_hugetlb(_size, 30);
+	}
+	if (!p && (hugepages == "1gb" || hugepages == "2mb")) {
+		_size = round_up(size, huge_page_2mb);
+		p = map_hugetlb(_size, 21);
+		if (!p) {
+			std::cerr << "Warning: no hugetlb page available for the arena, "
+			          << "using transparent huge pages" << std::endl;
+		}
+	}
+	if (!p) {
+		// 2MB granularity keeps every page of the arena huge page friendly
+		const bool huge_pages = hugepages != "none";
+		_size = round_up(size, huge_pages ? huge_page_2mb
+		                                  : static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+		p = map_pages(_size, huge_pages);
+	}
+	if (!p) {
+		_size = 0;
+		return;
+	}
+	place(p, _size, numa_policy, numa_node);
+	// fault every page in now, not during the first measured run
+	const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	for (size_t off = 0; off < _size; off += page) {
+		static_cast<volatile char *>(p)[off] = 0;
+	}
+	_data = p;
+}
+
+Arena::~Arena() {
+	if (_data) {
+		munmap(_data, _size);
+	}
+}
@@ -0,0 +1,34 @@
+#ifndef _ARENA_HPP_
+#define _ARENA_HPP_
+
+#include <stddef.h>
+
+#include <string>
+
+// Pre-faulted memory region lent to the versions through
+// polybench_set_arena. Kernel arrays are carved out of it and the whole
+// arena is reset before each run, so that repeated runs neither map nor
+// fault in their data again.
+class Arena {
+ public:
+	// size is rounded up to whole pages. The pages are backed and placed as
+	// polybench.c would back and place the arrays themselves: hugepages is
+	// none, thp, 2mb or 1gb (hugetlb, falling back to smaller pages, then to
+	// thp), numa_policy default, local, interleave or bind (to numa_node).
+	Arena(size_t size, const std::string &hugepages,
+	      const std::string &numa_policy, int numa_node);
+	~Arena();
+
+	Arena(const Arena &) = delete;
+	Arena &operator=(const Arena &) = delete;
+
+	// nullptr when the mapping failed
+	void *data() const { return _data; }
+	size_t size() const { return _size; }
+
+ private:
+	void *_data;
+	size_t _size;
+};
+
+#endif /* end of include guard: _ARENA_HPP_ */
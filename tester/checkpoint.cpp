@@ -0,0 +1,51 @@
+#include "checkpoint.hpp"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+// terminates complete lines
+static const std::string checkpoint_end = "\tdone";
+
+static std::string get_checkpoint_key(const run_element_t &job) {
+	return job.label + "\t" + job.options;
+}
+
+Checkpoint::Checkpoint(const std::string &path) {
+	std::ifstream in(path);
+	std::string line;
+	bool truncated = false;
+	while (std::getline(in, line)) {
+		// a sweep killed while writing leaves a partial last line
+		truncated = in.eof();
+		const size_t end = line.size() - std::min(line.size(), checkpoint_end.size());
+		if (!truncated && line.compare(end, std::string::npos, checkpoint_end) == 0) {
+			_done.insert(line.substr(0, end));
+		}
+	}
+	_fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+	if (_fd >= 0 && truncated && write(_fd, "\n", 1) != 1) {
+		close(_fd);
+		_fd = -1;
+	}
+}
+
+Checkpoint::~Checkpoint() {
+	if (_fd >= 0) {
+		close(_fd);
+	}
+}
+
+bool Checkpoint::done(const run_element_t &job) const {
+	return _done.count(get_checkpoint_key(job)) != 0;
+}
+
+void Checkpoint::mark(const run_element_t &job) {
+	// labels and options hold no newline, one write keeps lines whole
+	const std::string line = get_checkpoint_key(job) + checkpoint_end + "\n";
+	if (_fd < 0 || write(_fd, line.data(), line.size()) != static_cast<ssize_t>(line.size())) {
+		std::cerr << "Error while checkpointing " << job.label << std::endl;
+	}
+}
@@ -0,0 +1,33 @@
+#ifndef _CHECKPOINT_HPP_
+#define _CHECKPOINT_HPP_
+
+#include "runner.hpp"
+
+#include <set>
+#include <string>
+
+// Versions completed by previous runs of an interrupted sweep. Each
+// successful version appends a line to the checkpoint file; a resumed sweep
+// skips them without compiling them again. Versions are identified by label
+// and compiler options, so a sweep with other options runs everything again.
+class Checkpoint {
+ public:
+	explicit Checkpoint(const std::string &path);
+	~Checkpoint();
+	Checkpoint(const Checkpoint &) = delete;
+	Checkpoint &operator=(const Checkpoint &) = delete;
+
+	bool is_open() const { return _fd >= 0; }
+	size_t size() const { return _done.size(); }
+
+	// completed by a previous run
+	bool done(const run_element_t &job) const;
+	// safe to call from concurrent workers
+	void mark(const run_element_t &job);
+
+ private:
+	int _fd;
+	std::set<std::string> _done;
+};
+
+#endif /* end of include guard: _CHECKPOINT_HPP_ */
@@ -0,0 +1,133 @@
+#include "compare.hpp"
+#include "stats.hpp"
+
+#include <sstream>
+#include <stdlib.h>
+
+static const char *compare_key_fields[] = {
+	"category", "kernel", "size", "type", "memory", "layout",
+};
+
+static std::string get_compare_key(const result_record_t &record) {
+	std::string key;
+	for (const char *f : compare_key_fields) {
+		const auto it = record.find(f);
+		key += (it == record.end() ? std::string() : it->second) + "\t";
+	}
+	return key;
+}
+
+static std::vector<double> get_trials(const result_record_t &record) {
+	std::vector<double> trials;
+	const auto it = record.find("trials");
+	if (it == record.end()) {
+		return trials;
+	}
+	std::stringstream ss(it->second);
+	std::string t;
+	while (std::getline(ss, t, ',')) {
+		trials.push_back(strtod(t.c_str(), nullptr));
+	}
+	return trials;
+}
+
+BaselineComparison::BaselineComparison(double threshold, double alpha)
+    : _threshold(threshold), _alpha(alpha) {}
+
+bool BaselineComparison::load(const std::string &path) {
+	std::vector<result_record_t> records;
+	if (!load_result_records(path, records)) {
+		return false;
+	}
+	// stores are append-only: later records override earlier ones
+	for (const auto &r : records) {
+		const auto status = r.find("status");
+		if (status != r.end() && status->second == "ok") {
+			_baseline[get_compare_key(r)] = r;
+		}
+	}
+	return true;
+}
+
+void BaselineComparison::add(const run_element_t &job, const run_result_t &res) {
+	if (!res.ok) {
+		return;
+	}
+	const result_record_t version = make_result_record(job, res);
+	const std::string key = get_compare_key(version);
+	std::lock_guard<std::mutex> lock(_mtx);
+	entry_t &e = _entries[key];
+	for (const char *f : compare_key_fields) {
+		e.version[f] = version.at(f);
+	}
+	e.current.insert(e.current.end(), res.trials.begin(), res.trials.end());
+	const auto base = _baseline.find(key);
+	if (base != _baseline.end()) {
+		e.baseline = get_trials(base->second);
+		const auto cpu = base->second.find("cpu");
+		e.baseline_cpu = (cpu == base->second.end()) ? "" : cpu->second;
+	}
+}
+
+size_t BaselineComparison::report(std::ostream &out, std::ostream *verdict) const {
+	std::lock_guard<std::mutex> lock(_mtx);
+	const std::string cpu = get_run_context()["cpu"];
+	size_t regressions = 0, improvements = 0, missing = 0;
+	for (const auto &it : _entries) {
+		const entry_t &e = it.second;
+		result_record_t r = e.version;
+		if (e.baseline.empty()) {
+			r["verdict"] = "missing";
+			missing++;
+		} else {
+			const double ratio = median(e.current) / median(e.baseline);
+			const double p = mann_whitney_p(e.baseline, e.current);
+			double low = 0, high = 0;
+			bootstrap_median_ratio_ci(e.baseline, e.current, 1 - _alpha, 2000, low, high);
+			r["verdict"] = "unchanged";
+			if (p < _alpha && ratio > 1 + _threshold) {
+				r["verdict"] = "regression";
+				regressions++;
+			} else if (p < _alpha && ratio < 1 - _threshold) {
+				r["verdict"] = "improvement";
+				improvements++;
+			}
+			r["ratio"] = std::to_string(ratio);
+			r["ci_low"] = std::to_string(low);
+			r["ci_high"] = std::to_string(high);
+			r["p"] = std::to_string(p);
+			if (!e.baseline_cpu.empty() && e.baseline_cpu != cpu) {
+				r["warning"] = "baseline from another cpu: " + e.baseline_cpu;
+			}
+		}
+		out << "compare " << r["category"] << " " << r["kernel"] << " - " << r["size"]
+		    << " - " << r["type"] << " " << r["memory"];
+		if (!r["layout"].empty()) {
+			out << " " << r["layout"];
+		}
+		out << ": " << r["verdict"];
+		if (r.count("ratio")) {
+			out << " ratio " << r["ratio"] << " [" << r["ci_low"] << ", " << r["ci_high"]
+			    << "] p " << r["p"];
+		}
+		if (r.count("warning")) {
+			out << " (" << r["warning"] << ")";
+		}
+		out << std::endl;
+		if (verdict) {
+			*verdict << format_result_record(r);
+		}
+	}
+	result_record_t summary;
+	summary["verdict"] = regressions ? "fail" : "pass";
+	summary["regressions"] = std::to_string(regressions);
+	summary["improvements"] = std::to_string(improvements);
+	summary["missing"] = std::to_string(missing);
+	out << "compare verdict " << summary["verdict"] << ": " << regressions
+	    << " regressions, " << improvements << " improvements, " << missing
+	    << " versions missing from the baseline" << std::endl;
+	if (verdict) {
+		*verdict << format_result_record(summary);
+	}
+	return regressions;
+}
@@ -0,0 +1,46 @@
+#ifndef _COMPARE_HPP_
+#define _COMPARE_HPP_
+
+#include "runner.hpp"
+#include "store.hpp"
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Compares the trials of the current sweep with those of a baseline result
+// store, version by version. The compiler and its options are expected to
+// differ: versions are matched on category, kernel, size, data type, memory
+// and layout, against the latest successful baseline record.
+class BaselineComparison {
+ public:
+	// threshold: relative slowdown tolerated (0.05: 5%),
+	// alpha: significance level of the Mann-Whitney test
+	BaselineComparison(double threshold, double alpha);
+
+	bool load(const std::string &path);
+	void add(const run_element_t &job, const run_result_t &res);
+
+	// Prints one line per version and the overall verdict to out, and the
+	// same as result store records to verdict when given. Returns the number
+	// of regressions.
+	size_t report(std::ostream &out, std::ostream *verdict) const;
+
+ private:
+	typedef struct ce_t {
+		result_record_t version;       // fields of the matching key
+		std::vector<double> baseline;
+		std::vector<double> current;
+		std::string baseline_cpu;
+	} entry_t;
+
+	double _threshold;
+	double _alpha;
+	std::map<std::string, result_record_t> _baseline;
+	mutable std::mutex _mtx;
+	std::map<std::string, entry_t> _entries;
+};
+
+#endif /* end of include guard: _COMPARE_HPP_ */
@@ -0,0 +1,183 @@
+#include "dispatch.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <math.h>
+#include <random>
+
+void SizeDispatcher::add(const entry_t &best) {
+	auto it = _entries.begin();
+	while (it != _entries.end() && it->footprint < best.footprint) {
+		++it;
+	}
+	_entries.insert(it, best);
+	_thresholds.clear();
+	for (size_t e = 0; e + 1 < _entries.size(); e++) {
+		_thresholds.push_back(static_cast<unsigned long long>(
+		                      sqrt(static_cast<double>(_entries[e].footprint) *
+		                           static_cast<double>(_entries[e + 1].footprint))));
+	}
+}
+
+const SizeDispatcher::entry_t &SizeDispatcher::select(unsigned long long footprint) const {
+	const size_t e = std::lower_bound(_thresholds.begin(), _thresholds.end(), footprint) -
+	                 _thresholds.begin();
+	return _entries[e];
+}
+
+// a tuned variant of one size
+typedef struct tv_t {
+	run_element_t job;
+	run_result_t res;
+	runner_symbols_t sym;
+} tuned_variant_t;
+
+// one kernel run as in run_job, without compilation nor statistics
+static double call_variant(const tuned_variant_t &t, const run_config_t &cfg) {
+	const runner_symbols_t &sym = t.sym;
+	char* runningArgv[] = { nullptr };
+	const Arena *arena = get_arena(cfg, t.job);
+	if (arena && sym.set_arena) {
+		sym.set_arena(arena->data(), arena->size());
+	}
+	if (!cfg.run_cpus.empty()) {
+		pin_current_thread(cfg.run_cpus);
+	}
+	sym.run(0, runningArgv);
+	if (!cfg.compile_cpus.empty()) {
+		pin_current_thread(cfg.compile_cpus);
+	}
+	return sym.elapsed ? sym.elapsed() : 0;
+}
+
+// tunes, dispatches and reports one kernel, false when nothing could run
+static bool dispatch_kernel(const std::string &name,
+                            const std::vector<run_element_t> &sizes,
+                            const harness_options_t &opts,
+                            const run_config_t &cfg,
+                            std::vector<tuned_variant_t> &tuned_all) {
+	std::vector<std::string> variants(1, "baseline");
+	variants.insert(variants.end(), opts.adaptive_flags.begin(), opts.adaptive_flags.end());
+
+	// tuning: every variant of every size, only sizes where all of them run
+	std::vector<std::vector<tuned_variant_t> > tuned;
+	for (const auto &job : sizes) {
+		std::vector<tuned_variant_t> row;
+		for (size_t v = 0; v < variants.size(); v++) {
+			tuned_variant_t t;
+			t.job = v ? make_variant(job, variants[v]) : job;
+			t.res = run_job(t.job, cfg);
+			if (t.res.ok) {
+				load_runner_symbols(*t.job.version, t.sym);
+			}
+			tuned_all.push_back(t);
+			row.push_back(t);
+		}
+		if (std::all_of(row.begin(), row.end(),
+		                [](const tuned_variant_t &t) { return t.res.ok; })) {
+			tuned.push_back(row);
+		}
+	}
+	if (tuned.empty()) {
+		return false;
+	}
+
+	SizeDispatcher dispatcher;
+	std::vector<unsigned long long> footprints;
+	for (const auto &row : tuned) {
+		size_t best = 0;
+		for (size_t v = 1; v < row.size(); v++) {
+			if (row[v].res.elapsed < row[best].res.elapsed) {
+				best = v;
+			}
+		}
+		SizeDispatcher::entry_t e;
+		e.footprint = row[best].res.alloc.peak_bytes;
+		e.variant = best;
+		e.label = variants[best];
+		dispatcher.add(e);
+		footprints.push_back(e.footprint);
+		std::cout << "dispatch " << name << " - " << row[best].job.size << " ("
+		          << e.footprint << " bytes): " << e.label << " " << row[best].res.elapsed
+		          << " s, baseline " << row[0].res.elapsed << " s" << std::endl;
+	}
+	// one size fits all: the choice made when tuning the largest size only
+	const size_t largest = std::max_element(footprints.begin(), footprints.end()) -
+	                       footprints.begin();
+	const size_t static_variant = dispatcher.select(footprints[largest]).variant;
+
+	// mixed-size workload, the same sequence for both strategies
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<size_t> pick(0, tuned.size() - 1);
+	std::vector<size_t> workload(opts.dispatch_calls);
+	for (auto &s : workload) {
+		s = pick(gen);
+	}
+	double dispatched_time = 0, static_time = 0;
+	for (const size_t s : workload) {
+		const SizeDispatcher::entry_t &e = dispatcher.select(footprints[s]);
+		dispatched_time += call_variant(tuned[s][e.variant], cfg);
+		static_time += call_variant(tuned[s][static_variant], cfg);
+	}
+
+	// the lookup alone, too short to be timed call by call
+	const size_t lookups = 1000000;
+	volatile size_t sink = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t l = 0; l < lookups; l++) {
+		sink = dispatcher.select(footprints[workload[l % workload.size()]]).variant;
+	}
+	const double lookup_ns = std::chrono::duration<double, std::nano>(
+	                         std::chrono::steady_clock::now() - start).count() / lookups;
+	(void)sink;
+
+	std::cout << "dispatch " << name << " workload of " << workload.size() << " calls: "
+	          << "dispatched " << dispatched_time << " s, static (" << variants[static_variant]
+	          << ") " << static_time << " s, gain "
+	          << (dispatched_time > 0 ? static_time / dispatched_time : 0)
+	          << "x, lookup " << lookup_ns << " ns per call ("
+	          << (dispatched_time > 0 ? 1e-7 * lookup_ns * workload.size() / dispatched_time : 0)
+	          << "% of the workload)" << std::endl;
+	return true;
+}
+
+size_t run_dispatch(JobGenerator &jobs,
+                    const harness_options_t &opts,
+                    const run_config_t &cfg,
+                    const result_handler_t &on_result) {
+	// the sweep goes size by size: gather the sizes of every kernel first
+	std::map<std::string, std::vector<run_element_t> > kernels;
+	std::vector<std::string> order;
+	run_element_t j;
+	while (jobs.next(j)) {
+		std::string name = j.category + " " + j.kernel + " - " + j.data_type + " " + j.memory;
+		if (!j.layout.empty()) {
+			name += " " + j.layout;
+		}
+		if (!kernels.count(name)) {
+			order.push_back(name);
+		}
+		kernels[name].push_back(j);
+	}
+
+	size_t failed = 0;
+	for (const auto &name : order) {
+		std::vector<tuned_variant_t> tuned;
+		if (!dispatch_kernel(name, kernels[name], opts, cfg, tuned)) {
+			std::cerr << "Error while tuning " << name << std::endl;
+		}
+		for (const auto &t : tuned) {
+			if (!t.res.ok) {
+				failed++;
+			}
+			if (on_result) {
+				on_result(t.job, t.res);
+			}
+		}
+		kernels.erase(name);
+	}
+	return failed;
+}
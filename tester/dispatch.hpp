@@ -0,0 +1,45 @@
+#ifndef _DISPATCH_HPP_
+#define _DISPATCH_HPP_
+
+#include "options.hpp"
+#include "runner.hpp"
+#include "sweep.hpp"
+
+#include <string>
+#include <vector>
+
+// Call time selection among the variants of a kernel, by problem size.
+// Sizes are measured as the memory footprint of the kernel arrays. The
+// decision table holds the best variant tuned at each footprint; calls of
+// other sizes go to the closest one, the threshold between two tuned
+// footprints being their geometric mean.
+class SizeDispatcher {
+ public:
+	typedef struct de_t {
+		unsigned long long footprint;  // bytes allocated by the tuned size
+		size_t variant;                // index of the winning variant
+		std::string label;             // its extra flags
+	} entry_t;
+
+	void add(const entry_t &best);
+	// dispatch table entry of a problem of footprint bytes
+	const entry_t &select(unsigned long long footprint) const;
+	bool empty() const { return _entries.empty(); }
+
+ private:
+	std::vector<entry_t> _entries;                 // by increasing footprint
+	std::vector<unsigned long long> _thresholds;   // upper bound of each entry
+};
+
+// Tunes every version of jobs with each variant of opts.adaptive_flags,
+// builds a SizeDispatcher per kernel, data type and memory setup from the
+// tuning, then runs a mixed-size workload of opts.dispatch_calls calls both
+// through the dispatcher and with the variant that is best at the largest
+// size, reporting the gain and the dispatch overhead. The tuning results are
+// passed to on_result. Returns the number of failures.
+size_t run_dispatch(JobGenerator &jobs,
+                    const harness_options_t &opts,
+                    const run_config_t &cfg,
+                    const result_handler_t &on_result = nullptr);
+
+#endif /* end of include guard: _DISPATCH_HPP_ */
@@ -0,0 +1,35 @@
+#include "hugepages.hpp"
+
+void HugepageReport::add(const run_element_t &job, const run_result_t &res) {
+	if (!res.ok || res.elapsed <= 0) {
+		return;
+	}
+	std::string version = job.category + " " + job.kernel + " - " + job.size + " - " +
+	                      job.data_type;
+	if (!job.layout.empty()) {
+		version += " - " + job.layout;
+	}
+	std::lock_guard<std::mutex> lock(_mtx);
+	if (_times.find(version) == _times.end()) {
+		_order.push_back(version);
+		_times[version] = {"", 0, 0};
+	}
+	entry_t &e = _times[version];
+	if (job.pages == "none") {
+		e.small_pages = res.elapsed;
+	} else {
+		e.pages = job.pages;
+		e.huge_pages = res.elapsed;
+	}
+}
+
+void HugepageReport::print(std::ostream &out) const {
+	std::lock_guard<std::mutex> lock(_mtx);
+	for (const auto &version : _order) {
+		const entry_t &e = _times.at(version);
+		if (e.small_pages > 0 && e.huge_pages > 0) {
+			out << "hugepages speedup " << version << " (" << e.pages << "): "
+			    << e.small_pages / e.huge_pages << std::endl;
+		}
+	}
+}
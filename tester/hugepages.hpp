@@ -0,0 +1,32 @@
+#ifndef _HUGEPAGES_HPP_
+#define _HUGEPAGES_HPP_
+
+#include "runner.hpp"
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Pairs the 4K page and huge page runs of every version built by
+// --compare-hugepages, whatever order they complete in, and reports the
+// speedup of huge pages.
+class HugepageReport {
+ public:
+	void add(const run_element_t &job, const run_result_t &res);
+	void print(std::ostream &out) const;
+
+ private:
+	typedef struct hp_t {
+		std::string pages;  // huge page mode of the second run
+		double small_pages; // elapsed with 4K pages (0: not run)
+		double huge_pages;  // elapsed with huge pages (0: not run)
+	} entry_t;
+
+	mutable std::mutex _mtx;
+	std::vector<std::string> _order;  // versions, in order of arrival
+	std::map<std::string, entry_t> _times;
+};
+
+#endif /* end of include guard: _HUGEPAGES_HPP_ */
@@ -1,4 +1,18 @@
 #include "versioningCompiler/Version.hpp"
+#include "adaptive.hpp"
+#include "affinity.hpp"
+#include "checkpoint.hpp"
+#include "compare.hpp"
+#include "dispatch.hpp"
+#include "hugepages.hpp"
+#include "options.hpp"
+#include "padding.hpp"
+#include "runner.hpp"
+#include "scaling.hpp"
+#include "store.hpp"
+#include "sweep.hpp"
+#include "throughput.hpp"
+#include "variants.hpp"
 
 #ifdef HAVE_CLANG_LIB
 #include "versioningCompiler/CompilerImpl/ClangLibCompiler.hpp"
@@ -6,38 +20,82 @@
 #include "versioningCompiler/CompilerImpl/SystemCompiler.hpp"
 #endif
 
+#include <errno.h>
+#include <fstream>
 #include <iostream>
 #include <list>
+#include <memory>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
 #ifndef POLYBENCH_SOURCE_DIRECTORY
 #define POLYBENCH_SOURCE_DIRECTORY "../polybench-c-4.2.1-beta"
 #endif
 const std::string polybench_source = POLYBENCH_SOURCE_DIRECTORY;
 
-typedef std::pair<std::string, vc::Option> list_element_t;
-typedef std::pair<std::string, std::shared_ptr<vc::Version> > run_element_t;
-typedef int (main_signature_t)(int argc, char*argv[]);
+int main(int argc, char const *argv[]) {
+	harness_options_t opts;
+	if (!parse_harness_options(argc, argv, opts)) {
+		return opts.help ? 0 : 1;
+	}
 
-typedef struct kd_t{
-	std::string kernel_label;
-	std::string kernel_folder;
-	std::string fileName;
-	std::string function_name;
-	std::list<list_element_t> data_type_option_list;
-} kernel_descriptor_t;
+	if (!opts.show_store.empty()) {
+		std::vector<result_record_t> records;
+		if (!load_result_records(opts.show_store, records)) {
+			std::cerr << "Error while reading result store " << opts.show_store << std::endl;
+			return 1;
+		}
+		std::vector<result_record_t> selected;
+		for (auto &r : records) {
+			if (is_selected(opts, r["category"], r["kernel"], r["size"], r["type"])) {
+				selected.push_back(r);
+			}
+		}
+		print_result_records(std::cout, selected);
+		return 0;
+	}
 
-typedef struct cat_t {
-	std::string category_label;
-	std::string category_folder;
-	std::list<kernel_descriptor_t> kernel_config_list;
-} category_t;
+	// throughput workers own a group each: OpenMP teams inherit its mask
+	if (opts.throughput && opts.worker_group_size > 0) {
+		setenv("OMP_NUM_THREADS", std::to_string(opts.worker_group_size).c_str(), 0);
+	}
+
+	// placement: kernels on measure_cpus, everything else on housekeeping_cpus
+	const bool pinning = !opts.measure_cpus.empty();
+	if (pinning) {
+		if (opts.check_isolation) {
+			if (!cpu_list_contains(get_isolated_cpus(), opts.measure_cpus)) {
+				std::cerr << "Warning: measure cpus " << format_cpu_list(opts.measure_cpus)
+				          << " are not isolated (isolcpus="
+				          << format_cpu_list(get_isolated_cpus()) << ")" << std::endl;
+			}
+			if (!cpu_list_contains(get_nohz_full_cpus(), opts.measure_cpus)) {
+				std::cerr << "Warning: measure cpus " << format_cpu_list(opts.measure_cpus)
+				          << " are not tickless (nohz_full="
+				          << format_cpu_list(get_nohz_full_cpus()) << ")" << std::endl;
+			}
+		}
+		if (!opts.throughput) {
+			set_openmp_placement(opts.measure_cpus);
+		}
+		if (opts.housekeeping_cpus.empty()) {
+			std::cerr << "Warning: no cpu left for housekeeping, "
+			          << "compilers will share the measure cpus" << std::endl;
+			opts.housekeeping_cpus = opts.measure_cpus;
+		}
+		if (!pin_current_thread(opts.housekeeping_cpus)) {
+			std::cerr << "Error while pinning the harness to cpus "
+			          << format_cpu_list(opts.housekeeping_cpus) << std::endl;
+			return 1;
+		}
+	}
 
-int main(int argc, char const *argv[]) {
 	// common options
 	const vc::opt_list_t default_options {
                 vc::make_option("-includeutils.hpp"),
                 vc::make_option("-O0"),
+                vc::make_option("-DPOLYBENCH_TIME"),
                 vc::make_option("-I" + polybench_source + "/utilities"),
                 vc::make_option("-I../include"),
 	};
@@ -82,15 +140,18 @@ int main(int argc, char const *argv[]) {
 
 	// create a compiler
 	std::shared_ptr<vc::Compiler> default_compiler;
+	std::string compiler_version;
 	#ifdef HAVE_CLANG_LIB
 	default_compiler = std::make_shared<vc::ClangLibCompiler>("ClangLibCompiler",
 	                                                          ".",
 	                                                          "compilation.log");
+	compiler_version = "ClangLibCompiler";
 	#else
 	default_compiler = std::make_shared<vc::SystemCompiler>("default_gcc",
 	                                                        "gcc",
 	                                                        ".",
 	                                                        "compilation.log");
+	compiler_version = get_compiler_version("gcc");
 	#endif
 
 	// declare kernel
@@ -128,84 +189,335 @@ int main(int argc, char const *argv[]) {
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// cache-blocked, vectorized gemm: only meaningful when optimized
+	k_tmp.kernel_label = "blas/gemm-blocked";
+	k_tmp.kernel_folder = "blas/gemm";
+	k_tmp.fileName = "gemm-blocked.c";
+	k_tmp.data_type_option_list = dataType_list_ifd;
+	k_tmp.extra_options = { vc::make_option("-O3") };
+	k_tmp.reference_file = "gemm.c";
+	category.kernel_config_list.push_back(k_tmp);
+
+	// multithreaded, see --scaling
+	k_tmp.kernel_label = "blas/gemm-parallel";
+	k_tmp.kernel_folder = "blas/gemm";
+	k_tmp.fileName = "gemm-parallel.c";
+	k_tmp.data_type_option_list = dataType_list_ifd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "gemm.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 3;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "blas/gemver";
 	k_tmp.kernel_folder = "blas/gemver";
 	k_tmp.fileName = "gemver.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// single pass over the matrix, see polybench_matvec.h
+	k_tmp.kernel_label = "blas/gemver-fused";
+	k_tmp.kernel_folder = "blas/gemver";
+	k_tmp.fileName = "gemver-fused.c";
+	k_tmp.data_type_option_list = dataType_list_ifd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "gemver.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 2;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "blas/gesummv";
 	k_tmp.kernel_folder = "blas/gesummv";
 	k_tmp.fileName = "gesummv.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// single pass over the matrix, see polybench_matvec.h
+	k_tmp.kernel_label = "blas/gesummv-fused";
+	k_tmp.kernel_folder = "blas/gesummv";
+	k_tmp.fileName = "gesummv-fused.c";
+	k_tmp.data_type_option_list = dataType_list_fd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "gesummv.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 2;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
+	k_tmp.kernel_label = "blas/symm";
+	k_tmp.kernel_folder = "blas/symm";
+	k_tmp.fileName = "symm.c";
+	k_tmp.data_type_option_list = dataType_list_ifd;
+	category.kernel_config_list.push_back(k_tmp);
+
+	// symmetric product as a blocked general one, multithreaded
+	k_tmp.kernel_label = "blas/symm-blocked";
+	k_tmp.kernel_folder = "blas/symm";
+	k_tmp.fileName = "symm-blocked.c";
+	k_tmp.data_type_option_list = dataType_list_ifd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "symm.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 3;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "blas/syr2k";
 	k_tmp.kernel_folder = "blas/syr2k";
 	k_tmp.fileName = "syr2k.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// packed triangle, multithreaded
+	k_tmp.kernel_label = "blas/syr2k-packed";
+	k_tmp.kernel_folder = "blas/syr2k";
+	k_tmp.fileName = "syr2k-packed.c";
+	k_tmp.data_type_option_list = dataType_list_ifd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "syr2k.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 3;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "blas/syrk";
 	k_tmp.kernel_folder = "blas/syrk";
 	k_tmp.fileName = "syrk.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// packed triangle, multithreaded
+	k_tmp.kernel_label = "blas/syrk-packed";
+	k_tmp.kernel_folder = "blas/syrk";
+	k_tmp.fileName = "syrk-packed.c";
+	k_tmp.data_type_option_list = dataType_list_ifd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "syrk.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 3;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "blas/trmm";
 	k_tmp.kernel_folder = "blas/trmm";
 	k_tmp.fileName = "trmm.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// packed triangle, multithreaded
+	k_tmp.kernel_label = "blas/trmm-packed";
+	k_tmp.kernel_folder = "blas/trmm";
+	k_tmp.fileName = "trmm-packed.c";
+	k_tmp.data_type_option_list = dataType_list_ifd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "trmm.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 3;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "ker/2mm";
 	k_tmp.kernel_folder = "kernels/2mm";
 	k_tmp.fileName = "2mm.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	k_tmp.kernel_label = "ker/2mm-parallel";
+	k_tmp.kernel_folder = "kernels/2mm";
+	k_tmp.fileName = "2mm-parallel.c";
+	k_tmp.data_type_option_list = dataType_list_fd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "2mm.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 3;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+
+	// chained products evaluated by row panels, in the cheapest order
+	k_tmp.kernel_label = "ker/2mm-fused";
+	k_tmp.kernel_folder = "kernels/2mm";
+	k_tmp.fileName = "2mm-fused.c";
+	k_tmp.data_type_option_list = dataType_list_fd;
+	k_tmp.extra_options = { vc::make_option("-O3") };
+	k_tmp.reference_file = "2mm.c";
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "ker/3mm";
 	k_tmp.kernel_folder = "kernels/3mm";
 	k_tmp.fileName = "3mm.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	k_tmp.kernel_label = "ker/3mm-parallel";
+	k_tmp.kernel_folder = "kernels/3mm";
+	k_tmp.fileName = "3mm-parallel.c";
+	k_tmp.data_type_option_list = dataType_list_fd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "3mm.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 3;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+
+	// chained products evaluated by row panels, in the cheapest order
+	k_tmp.kernel_label = "ker/3mm-fused";
+	k_tmp.kernel_folder = "kernels/3mm";
+	k_tmp.fileName = "3mm-fused.c";
+	k_tmp.data_type_option_list = dataType_list_fd;
+	k_tmp.extra_options = { vc::make_option("-O3") };
+	k_tmp.reference_file = "3mm.c";
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "ker/atax";
 	k_tmp.kernel_folder = "kernels/atax";
 	k_tmp.fileName = "atax.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// single pass over the matrix, see polybench_matvec.h
+	k_tmp.kernel_label = "ker/atax-fused";
+	k_tmp.kernel_folder = "kernels/atax";
+	k_tmp.fileName = "atax-fused.c";
+	k_tmp.data_type_option_list = dataType_list_fd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "atax.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 2;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "ker/bicg";
 	k_tmp.kernel_folder = "kernels/bicg";
 	k_tmp.fileName = "bicg.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// single pass over the matrix, see polybench_matvec.h
+	k_tmp.kernel_label = "ker/bicg-fused";
+	k_tmp.kernel_folder = "kernels/bicg";
+	k_tmp.fileName = "bicg-fused.c";
+	k_tmp.data_type_option_list = dataType_list_fd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "bicg.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 2;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "ker/doitgen";
 	k_tmp.kernel_folder = "kernels/doitgen";
 	k_tmp.fileName = "doitgen.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// batched product as one blocked GEMM, multithreaded over r
+	k_tmp.kernel_label = "ker/doitgen-blocked";
+	k_tmp.kernel_folder = "kernels/doitgen";
+	k_tmp.fileName = "doitgen-blocked.c";
+	k_tmp.data_type_option_list = dataType_list_fd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "doitgen.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 4;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "ker/mvt";
 	k_tmp.kernel_folder = "kernels/mvt";
 	k_tmp.fileName = "mvt.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// single pass over the matrix, see polybench_matvec.h
+	k_tmp.kernel_label = "ker/mvt-fused";
+	k_tmp.kernel_folder = "kernels/mvt";
+	k_tmp.fileName = "mvt-fused.c";
+	k_tmp.data_type_option_list = dataType_list_ifd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "mvt.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 2;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "solv/cholesky";
 	k_tmp.kernel_folder = "solvers/cholesky";
 	k_tmp.fileName = "cholesky.c";
 	k_tmp.data_type_option_list = dataType_list_fd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// tiled, with task-parallel trailing updates
+	k_tmp.kernel_label = "solv/cholesky-blocked";
+	k_tmp.kernel_folder = "solvers/cholesky";
+	k_tmp.fileName = "cholesky-blocked.c";
+	k_tmp.data_type_option_list = dataType_list_fd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "cholesky.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 3;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "solv/durbin";
 	k_tmp.kernel_folder = "solvers/durbin";
 	k_tmp.fileName = "durbin.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	k_tmp.kernel_label = "solv/durbin-inplace";
+	k_tmp.kernel_folder = "solvers/durbin";
+	k_tmp.fileName = "durbin-inplace.c";
+	k_tmp.data_type_option_list = dataType_list_fd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp-simd") };
+	k_tmp.reference_file = "durbin.c";
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "solv/gramschmidt";
 	k_tmp.kernel_folder = "solvers/gramschmidt";
 	k_tmp.fileName = "gramschmidt.c";
@@ -218,18 +530,62 @@ int main(int argc, char const *argv[]) {
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// tiled, with task-parallel trailing updates
+	k_tmp.kernel_label = "solv/lu-blocked";
+	k_tmp.kernel_folder = "solvers/lu";
+	k_tmp.fileName = "lu-blocked.c";
+	k_tmp.data_type_option_list = dataType_list_ifd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "lu.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 3;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "solv/ludcmp";
 	k_tmp.kernel_folder = "solvers/ludcmp";
 	k_tmp.fileName = "ludcmp.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	// tiled factorization, see solv/lu-blocked
+	k_tmp.kernel_label = "solv/ludcmp-blocked";
+	k_tmp.kernel_folder = "solvers/ludcmp";
+	k_tmp.fileName = "ludcmp-blocked.c";
+	k_tmp.data_type_option_list = dataType_list_ifd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "ludcmp.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 3;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	k_tmp.kernel_label = "solv/trisolv";
 	k_tmp.kernel_folder = "solvers/trisolv";
 	k_tmp.fileName = "trisolv.c";
 	k_tmp.data_type_option_list = dataType_list_ifd;
 	category.kernel_config_list.push_back(k_tmp);
 
+	k_tmp.kernel_label = "solv/trisolv-blocked";
+	k_tmp.kernel_folder = "solvers/trisolv";
+	k_tmp.fileName = "trisolv-blocked.c";
+	k_tmp.data_type_option_list = dataType_list_ifd;
+	k_tmp.extra_options = { vc::make_option("-O3"), vc::make_option("-fopenmp") };
+	k_tmp.reference_file = "trisolv.c";
+	k_tmp.parallel = true;
+	k_tmp.work_exponent = 2;
+	category.kernel_config_list.push_back(k_tmp);
+	k_tmp.parallel = false;
+	k_tmp.work_exponent = 0;
+	k_tmp.extra_options.clear();
+	k_tmp.reference_file.clear();
+
 	configList.push_back(category);
 
 	// medley
@@ -300,54 +656,174 @@ int main(int argc, char const *argv[]) {
 
 	configList.push_back(category);
 
-	// preparing versions
-	vc::Version::Builder builder;
-	std::list<run_element_t> jobList;
-
-	for (const auto &size : size_list) {
-		for (const auto &cat : configList) {
-			for (const auto &k : cat.kernel_config_list) {
-				for (const auto &datatype : k.data_type_option_list) {
-					builder.reset();
-					const std::string label = cat.category_label + " " +
-					                          k.kernel_label + " - " +
-					                          size.first + " - " +
-					                          datatype.first;
-					builder._compiler = default_compiler;
-					const std::string kernelSourceDir = polybench_source + "/" +
-					                                    cat.category_folder + "/" +
-					                                    k.kernel_folder;
-					builder.addIncludeDir(kernelSourceDir);
-					vc::opt_list_t options = {
-						size.second,
-						datatype.second,
-					};
-					options.insert(options.end(), default_options.begin(), default_options.end());
-					builder.options(options);
-					builder.addSourceFile(kernelSourceDir + "/" + k.fileName);
-					builder.addSourceFile(polybench_source + "/utilities/polybench.c");
-					builder._functionName = {k.function_name};
-					jobList.push_back(std::make_pair(label, builder.build()));
+	// preparing versions: built one at a time, when they are about to run
+	sweep_space_t space;
+	space.sizes = size_list;
+	space.categories = configList;
+	space.page_variants = get_hugepage_variants(opts);
+	space.layouts = get_layout_variants(opts);
+	space.default_options = default_options;
+	space.compiler = default_compiler;
+	space.compiler_version = compiler_version;
+	space.source_dir = polybench_source;
+	#ifdef HAVE_CLANG_LIB
+	space.clang = true;
+	#else
+	space.clang = false;
+	#endif
+	if (opts.remarks) {
+		space.remarks_dir = "remarks";
+		if (mkdir(space.remarks_dir.c_str(), 0755) != 0 && errno != EEXIST) {
+			std::cerr << "Error while creating " << space.remarks_dir << std::endl;
+			return 1;
+		}
+	}
+	std::unique_ptr<Checkpoint> checkpoint;
+	if (!opts.checkpoint_path.empty()) {
+		checkpoint.reset(new Checkpoint(opts.checkpoint_path));
+		if (!checkpoint->is_open()) {
+			std::cerr << "Error while opening checkpoint " << opts.checkpoint_path << std::endl;
+			return 1;
+		}
+		std::cout << "resuming: " << checkpoint->size() << " versions already done"
+		          << std::endl;
+	}
+	JobGenerator jobs(space, opts, checkpoint.get());
+	VersionCache versions(opts.keep_versions);
+
+	PaddingReport padding_report;
+	VariantReport variant_report;
+	HugepageReport hugepage_report;
+	const bool padding_sweep = !space.layouts.front().label.empty();
+	std::unique_ptr<ResultStore> store;
+	if (!opts.store_path.empty()) {
+		store.reset(new ResultStore(opts.store_path));
+		if (!store->is_open()) {
+			std::cerr << "Error while opening result store " << opts.store_path << std::endl;
+			return 1;
+		}
+	}
+	std::unique_ptr<BaselineComparison> comparison;
+	if (!opts.baseline_path.empty()) {
+		comparison.reset(new BaselineComparison(opts.threshold, 0.05));
+		if (!comparison->load(opts.baseline_path)) {
+			std::cerr << "Error while reading baseline " << opts.baseline_path << std::endl;
+			return 1;
+		}
+	}
+	const result_handler_t on_result = [&](const run_element_t &j, const run_result_t &r) {
+		if (padding_sweep) {
+			padding_report.add(j, r);
+		}
+		variant_report.add(j, r);
+		if (opts.compare_hugepages) {
+			hugepage_report.add(j, r);
+		}
+		if (store && !store->append(make_result_record(j, r))) {
+			std::cerr << "Error while storing the result of " << j.label << std::endl;
+		}
+		if (comparison) {
+			comparison->add(j, r);
+		}
+		if (checkpoint && r.ok) {
+			checkpoint->mark(j);
+		}
+		versions.retire(j);
+	};
+	// reports once every job ran, the exit status of the harness
+	const auto finish = [&](size_t failed) {
+		if (checkpoint) {
+			std::cout << "resumed: skipped " << jobs.resumed() << " completed versions"
+			          << std::endl;
+		}
+		if (padding_sweep) {
+			padding_report.print(std::cout);
+		}
+		variant_report.print(std::cout);
+		if (opts.compare_hugepages) {
+			hugepage_report.print(std::cout);
+		}
+		size_t regressions = 0;
+		if (comparison) {
+			std::ofstream verdict;
+			if (!opts.verdict_path.empty()) {
+				verdict.open(opts.verdict_path);
+				if (!verdict) {
+					std::cerr << "Error while writing verdict " << opts.verdict_path << std::endl;
 				}
 			}
+			regressions = comparison->report(std::cout, verdict.is_open() ? &verdict : nullptr);
 		}
+		return failed ? 1 : regressions ? 2 : 0;
+	};
+
+	if (opts.throughput) {
+		return finish(run_throughput(jobs, opts, on_result));
 	}
 
 	// compiling and running
-	char* runningArgv[] = {};
-	for (const auto &j : jobList) {
-		std::cout << "working on " << j.first << std::endl;
-		bool ok = j.second->compile();
-		if (!ok) {
-			std::cerr << "Error while compiling " << j.first << std::endl;
-			continue;
+	run_config_t run_cfg;
+	run_cfg.compile_cpus = opts.housekeeping_cpus;
+	run_cfg.run_cpus = opts.measure_cpus;
+	run_cfg.arena = nullptr;
+	run_cfg.small_page_arena = nullptr;
+	run_cfg.trials = opts.trials;
+	run_cfg.exclusive = true;
+	run_cfg.tolerance = opts.tolerance;
+	// arena pages are faulted in by the measurement cpus, as kernels would.
+	// Pages stay what they were faulted in as, so comparing huge pages takes
+	// a second arena of 4K pages.
+	std::unique_ptr<Arena> arena, small_page_arena;
+	if (opts.arena_size) {
+		if (pinning) {
+			pin_current_thread(opts.measure_cpus);
+		}
+		arena.reset(new Arena(opts.arena_size, opts.hugepages,
+		                      opts.numa_policy, opts.numa_node));
+		if (opts.compare_hugepages && opts.hugepages != "none") {
+			small_page_arena.reset(new Arena(opts.arena_size, "none",
+			                                 opts.numa_policy, opts.numa_node));
+		}
+		if (pinning) {
+			pin_current_thread(opts.housekeeping_cpus);
 		}
-		main_signature_t* run = reinterpret_cast<main_signature_t*>(j.second->getSymbol());
-		if (run) {
-			run(0, runningArgv);
+		if (!arena->data() || (small_page_arena && !small_page_arena->data())) {
+			std::cerr << "Error while allocating an arena of " << opts.arena_size
+			          << " bytes" << std::endl;
+			return 1;
 		}
-		j.second->fold();
+		run_cfg.arena = arena.get();
+		run_cfg.small_page_arena = small_page_arena.get();
 	}
-
-	return 0;
+	if (opts.adaptive_calls) {
+		return finish(run_adaptive(jobs, opts, run_cfg, on_result));
+	}
+	if (opts.dispatch_calls) {
+		return finish(run_dispatch(jobs, opts, run_cfg, on_result));
+	}
+	if (!opts.scaling_threads.empty()) {
+		return finish(run_scaling(jobs, opts, run_cfg, on_result));
+	}
+	size_t failed = 0;
+	run_element_t j;
+	while (jobs.next(j)) {
+		std::cout << "working on " << j.label << std::endl;
+		const run_result_t r = run_job(j, run_cfg);
+		on_result(j, r);
+		if (!r.ok) {
+			failed++;
+		} else {
+			std::cout << "placement " << describe_placement(r.placement) << " "
+			          << j.memory << std::endl;
+			std::cout << "memory " << describe_alloc_stats(r.alloc) << " "
+			          << describe_resource_usage(r.usage) << std::endl;
+			if (!j.remarks_file.empty()) {
+				std::cout << "vectorization " << describe_remarks(r.remarks) << std::endl;
+			}
+			if (r.validation.checked) {
+				std::cout << "validation " << describe_validation(r.validation) << std::endl;
+			}
+		}
+	}
+	return finish(failed);
 }
@@ -0,0 +1,464 @@
+#include "options.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <stdlib.h>
+
+void print_harness_usage(const std::string &exe_name) {
+	std::cerr << "usage: " << exe_name << " [options]" << std::endl
+	          << "  --measure-cpus=LIST       pin kernels (and their OpenMP teams) to LIST" << std::endl
+	          << "  --housekeeping-cpus=LIST  run compilers and the harness on LIST" << std::endl
+	          << "                            (default: every allowed cpu not in --measure-cpus)" << std::endl
+	          << "  --check-isolation         warn when measure cpus are not in isolcpus/nohz_full" << std::endl
+	          << "  --throughput              run versions concurrently, one worker per group" << std::endl
+	          << "                            of cpus sharing a last level cache slice" << std::endl
+	          << "  --group-size=N            cpus per throughput worker (default: whole slice)" << std::endl
+	          << "  --interference            put every throughput worker on the same slice" << std::endl
+	          << "                            to measure shared cache/bandwidth contention" << std::endl
+	          << "  --numa=POLICY             placement of the kernel arrays: default, local," << std::endl
+	          << "                            interleave, bind:NODE or first-touch (parallel init)" << std::endl
+	          << "  --hugepages=MODE          back the kernel arrays with huge pages: none, thp," << std::endl
+	          << "                            2mb or 1gb (hugetlb, falling back to thp)" << std::endl
+	          << "  --compare-hugepages       run every version with 4K pages and with" << std::endl
+	          << "                            --hugepages (thp by default)" << std::endl
+	          << "  --arena=SIZE              allocate kernel arrays from a pre-faulted arena of" << std::endl
+	          << "                            SIZE bytes (K, M, G suffixes), reset between runs" << std::endl
+	          << "                            (one arena per worker in throughput mode)" << std::endl
+	          << "  --trials=N                run every version N times (default: 1)" << std::endl
+	          << "  --padding=LIST            build every version with each of these comma" << std::endl
+	          << "                            separated POLYBENCH_PADDING_FACTOR values" << std::endl
+	          << "  --inter-padding=LIST      same for inter-array padding: each item is a" << std::endl
+	          << "                            factor in bytes or explicit per-array offsets a:b:c" << std::endl
+	          << "                            (the best layout of every kernel is reported)" << std::endl
+	          << "  --store=FILE              append every result, with its trials, counters," << std::endl
+	          << "                            compiler, options, host and harness revision to FILE" << std::endl
+	          << "  --show-store=FILE         print the results stored in FILE and exit" << std::endl
+	          << "  --baseline=FILE           compare every version with its latest result in" << std::endl
+	          << "                            the store FILE (Mann-Whitney test and bootstrap CI" << std::endl
+	          << "                            of the trials); exit with 2 on regressions" << std::endl
+	          << "  --threshold=PCT           slowdown tolerated by --baseline (default: 5)" << std::endl
+	          << "  --verdict=FILE            write the comparison as result store records" << std::endl
+	          << "  --kernel=REGEX            only run kernels whose label matches REGEX" << std::endl
+	          << "  --category=REGEX          same for categories (dm, la, med, sten)," << std::endl
+	          << "  --size=REGEX              sizes (mini, small, medium, large, xlarge)" << std::endl
+	          << "  --type=REGEX              and data types (int, float, double)" << std::endl
+	          << "  --checkpoint=FILE         record completed versions in FILE and skip" << std::endl
+	          << "                            those already there, to resume a sweep" << std::endl
+	          << "  --keep-versions=N         keep the last N versions loaded after their run" << std::endl
+	          << "                            (default: 0, unload every version once it ran)" << std::endl
+	          << "  --adaptive=CALLS          call every version CALLS times through an adaptive" << std::endl
+	          << "                            dispatcher, which compiles candidates in the" << std::endl
+	          << "                            background and swaps in the faster ones" << std::endl
+	          << "  --adaptive-flags=LIST     comma separated candidates, each a space separated" << std::endl
+	          << "                            list of extra flags (default: -O1,-O2,-O3)" << std::endl
+	          << "  --dispatch=CALLS          tune every kernel with the --adaptive-flags" << std::endl
+	          << "                            variants at each size, then run a mixed-size" << std::endl
+	          << "                            workload of CALLS calls through a size dispatcher" << std::endl
+	          << "  --scaling=LIST            strong and weak scaling of the parallel variants" << std::endl
+	          << "                            over comma separated thread counts (default" << std::endl
+	          << "                            filter: --size=large|xlarge)" << std::endl
+	          << "  --flags=FLAGS             space separated compiler flags added to every" << std::endl
+	          << "                            version, after the default -O0" << std::endl
+	          << "  --remarks                 report the vectorizer remarks of every version on" << std::endl
+	          << "                            its #pragma scop region (use with optimizing flags)" << std::endl
+	          << "  --validate[=TOL]          check the output of optimized kernel variants" << std::endl
+	          << "                            against their reference kernel (default: 0.02," << std::endl
+	          << "                            relative above 1, absolute below)" << std::endl
+	          << "  --help                    print this message" << std::endl
+	          << "cpu LIST syntax is the kernel one, e.g. 2-5,8" << std::endl;
+}
+
+// splits "--name=value" into name and value
+static void split_option(const std::string &arg, std::string &name, std::string &value) {
+	const size_t eq = arg.find('=');
+	name = arg.substr(0, eq);
+	value = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+}
+
+static bool parse_integer(const std::string &text, long &n) {
+	char *end = nullptr;
+	n = strtol(text.c_str(), &end, 10);
+	return !text.empty() && *end == '\0';
+}
+
+static std::vector<std::string> split_list(const std::string &text) {
+	std::vector<std::string> items;
+	size_t begin = 0;
+	while (begin <= text.size()) {
+		const size_t end = std::min(text.find(',', begin), text.size());
+		items.push_back(text.substr(begin, end - begin));
+		begin = end + 1;
+	}
+	return items;
+}
+
+// "512M" and friends, in bytes
+static bool parse_size(const std::string &text, size_t &size) {
+	char *end = nullptr;
+	const unsigned long long n = strtoull(text.c_str(), &end, 10);
+	if (text.empty() || end == text.c_str()) {
+		return false;
+	}
+	unsigned long long unit = 1;
+	switch (*end) {
+		case 'G': case 'g': unit <<= 10; // fall through
+		case 'M': case 'm': unit <<= 10; // fall through
+		case 'K': case 'k': unit <<= 10; end++; break;
+		default: break;
+	}
+	if (*end != '\0' || n == 0) {
+		return false;
+	}
+	size = static_cast<size_t>(n * unit);
+	return true;
+}
+
+bool parse_harness_options(int argc, char const *argv[], harness_options_t &opts) {
+	opts.measure_cpus.clear();
+	opts.housekeeping_cpus.clear();
+	opts.check_isolation = false;
+	opts.throughput = false;
+	opts.worker_group_size = 0;
+	opts.interference = false;
+	opts.numa_policy = "default";
+	opts.numa_node = 0;
+	opts.hugepages = "none";
+	opts.compare_hugepages = false;
+	opts.arena_size = 0;
+	opts.padding_factors.clear();
+	opts.inter_paddings.clear();
+	opts.trials = 1;
+	opts.store_path.clear();
+	opts.show_store.clear();
+	opts.baseline_path.clear();
+	opts.threshold = 0.05;
+	opts.verdict_path.clear();
+	opts.kernel_filter.clear();
+	opts.category_filter.clear();
+	opts.size_filter.clear();
+	opts.type_filter.clear();
+	opts.checkpoint_path.clear();
+	opts.keep_versions = 0;
+	opts.adaptive_calls = 0;
+	opts.adaptive_flags = { "-O1", "-O2", "-O3" };
+	opts.dispatch_calls = 0;
+	opts.scaling_threads.clear();
+	opts.extra_flags.clear();
+	opts.remarks = false;
+	opts.validate = false;
+	opts.tolerance = 0.02;
+	opts.help = false;
+
+	const std::string exe_name = argc > 0 ? argv[0] : "runPolyBenchSuite";
+	for (int i = 1; i < argc; i++) {
+		std::string name, value;
+		split_option(argv[i], name, value);
+		if (name == "--measure-cpus") {
+			if (!parse_cpu_list(value, opts.measure_cpus)) {
+				std::cerr << "Invalid cpu list " << value << std::endl;
+				return false;
+			}
+		} else if (name == "--housekeeping-cpus") {
+			if (!parse_cpu_list(value, opts.housekeeping_cpus)) {
+				std::cerr << "Invalid cpu list " << value << std::endl;
+				return false;
+			}
+		} else if (name == "--check-isolation") {
+			opts.check_isolation = true;
+		} else if (name == "--throughput") {
+			opts.throughput = true;
+		} else if (name == "--group-size") {
+			long n = 0;
+			if (!parse_integer(value, n) || n <= 0) {
+				std::cerr << "Invalid group size " << value << std::endl;
+				return false;
+			}
+			opts.worker_group_size = static_cast<size_t>(n);
+		} else if (name == "--interference") {
+			opts.throughput = true;
+			opts.interference = true;
+		} else if (name == "--numa") {
+			opts.numa_policy = value.substr(0, value.find(':'));
+			if (opts.numa_policy == "bind") {
+				char *end = nullptr;
+				const std::string node = value.size() > 5 ? value.substr(5) : "";
+				opts.numa_node = static_cast<int>(strtol(node.c_str(), &end, 10));
+				// polybench.c binds with a 64-bit node mask
+				if (node.empty() || *end != '\0' || opts.numa_node < 0 ||
+				    opts.numa_node >= 64) {
+					std::cerr << "Invalid NUMA node in " << value << std::endl;
+					return false;
+				}
+			} else if (opts.numa_policy != "default" && opts.numa_policy != "local" &&
+			           opts.numa_policy != "interleave" && opts.numa_policy != "first-touch") {
+				std::cerr << "Invalid NUMA policy " << value << std::endl;
+				return false;
+			}
+		} else if (name == "--hugepages") {
+			opts.hugepages = value;
+			if (value != "none" && value != "thp" && value != "2mb" && value != "1gb") {
+				std::cerr << "Invalid huge page mode " << value << std::endl;
+				return false;
+			}
+		} else if (name == "--compare-hugepages") {
+			opts.compare_hugepages = true;
+		} else if (name == "--arena") {
+			if (!parse_size(value, opts.arena_size)) {
+				std::cerr << "Invalid arena size " << value << std::endl;
+				return false;
+			}
+		} else if (name == "--trials") {
+			long n = 0;
+			if (!parse_integer(value, n) || n <= 0) {
+				std::cerr << "Invalid number of trials " << value << std::endl;
+				return false;
+			}
+			opts.trials = static_cast<unsigned int>(n);
+		} else if (name == "--padding") {
+			for (const auto &item : split_list(value)) {
+				long n = 0;
+				if (!parse_integer(item, n) || n < 0) {
+					std::cerr << "Invalid padding factor " << item << std::endl;
+					return false;
+				}
+				opts.padding_factors.push_back(static_cast<int>(n));
+			}
+		} else if (name == "--inter-padding") {
+			for (const auto &item : split_list(value)) {
+				// a factor, or offsets a:b:c: every field is a number
+				bool valid = true;
+				size_t begin = 0, end = 0;
+				while (valid && end != std::string::npos) {
+					end = item.find(':', begin);
+					const std::string field = item.substr(begin, end == std::string::npos ?
+					                                             end : end - begin);
+					valid = !field.empty() &&
+					        field.find_first_not_of("0123456789") == std::string::npos;
+					begin = end + 1;
+				}
+				if (!valid) {
+					std::cerr << "Invalid inter-array padding " << item << std::endl;
+					return false;
+				}
+				opts.inter_paddings.push_back(item);
+			}
+		} else if (name == "--store") {
+			if (value.empty()) {
+				std::cerr << "Missing result store file name" << std::endl;
+				return false;
+			}
+			opts.store_path = value;
+		} else if (name == "--show-store") {
+			if (value.empty()) {
+				std::cerr << "Missing result store file name" << std::endl;
+				return false;
+			}
+			opts.show_store = value;
+		} else if (name == "--baseline") {
+			if (value.empty()) {
+				std::cerr << "Missing baseline file name" << std::endl;
+				return false;
+			}
+			opts.baseline_path = value;
+		} else if (name == "--threshold") {
+			char *end = nullptr;
+			const double pct = strtod(value.c_str(), &end);
+			if (value.empty() || *end != '\0' || pct < 0) {
+				std::cerr << "Invalid threshold " << value << std::endl;
+				return false;
+			}
+			opts.threshold = pct / 100;
+		} else if (name == "--verdict") {
+			if (value.empty()) {
+				std::cerr << "Missing verdict file name" << std::endl;
+				return false;
+			}
+			opts.verdict_path = value;
+		} else if (name == "--kernel" || name == "--category" ||
+		           name == "--size" || name == "--type") {
+			try {
+				std::regex check(value);
+			} catch (const std::regex_error &e) {
+				std::cerr << "Invalid regular expression " << value << ": " << e.what() << std::endl;
+				return false;
+			}
+			if (name == "--kernel") {
+				opts.kernel_filter = value;
+			} else if (name == "--category") {
+				opts.category_filter = value;
+			} else if (name == "--size") {
+				opts.size_filter = value;
+			} else {
+				opts.type_filter = value;
+			}
+		} else if (name == "--checkpoint") {
+			if (value.empty()) {
+				std::cerr << "Missing checkpoint file name" << std::endl;
+				return false;
+			}
+			opts.checkpoint_path = value;
+		} else if (name == "--keep-versions") {
+			long n = 0;
+			if (!parse_integer(value, n) || n < 0) {
+				std::cerr << "Invalid number of versions " << value << std::endl;
+				return false;
+			}
+			opts.keep_versions = static_cast<size_t>(n);
+		} else if (name == "--adaptive") {
+			long n = 0;
+			if (!parse_integer(value, n) || n <= 0) {
+				std::cerr << "Invalid number of calls " << value << std::endl;
+				return false;
+			}
+			opts.adaptive_calls = static_cast<unsigned int>(n);
+		} else if (name == "--adaptive-flags") {
+			opts.adaptive_flags.clear();
+			for (const auto &item : split_list(value)) {
+				if (item.find_first_not_of(' ') == std::string::npos) {
+					std::cerr << "Empty adaptive candidate in " << value << std::endl;
+					return false;
+				}
+				opts.adaptive_flags.push_back(item);
+			}
+		} else if (name == "--dispatch") {
+			long n = 0;
+			if (!parse_integer(value, n) || n <= 0) {
+				std::cerr << "Invalid number of calls " << value << std::endl;
+				return false;
+			}
+			opts.dispatch_calls = static_cast<unsigned int>(n);
+		} else if (name == "--scaling") {
+			opts.scaling_threads.clear();
+			for (const auto &item : split_list(value)) {
+				long n = 0;
+				if (!parse_integer(item, n) || n <= 0) {
+					std::cerr << "Invalid thread count " << item << std::endl;
+					return false;
+				}
+				opts.scaling_threads.push_back(static_cast<unsigned int>(n));
+			}
+		} else if (name == "--flags") {
+			std::stringstream ss(value);
+			std::string flag;
+			while (ss >> flag) {
+				opts.extra_flags.push_back(flag);
+			}
+		} else if (name == "--remarks") {
+			opts.remarks = true;
+		} else if (name == "--validate") {
+			opts.validate = true;
+			if (!value.empty()) {
+				char *end = nullptr;
+				opts.tolerance = strtod(value.c_str(), &end);
+				if (*end != '\0' || opts.tolerance < 0) {
+					std::cerr << "Invalid tolerance " << value << std::endl;
+					return false;
+				}
+			}
+		} else if (name == "--help") {
+			print_harness_usage(exe_name);
+			opts.help = true;
+			return false;
+		} else {
+			std::cerr << "Unknown option " << argv[i] << std::endl;
+			print_harness_usage(exe_name);
+			return false;
+		}
+	}
+
+	if ((opts.adaptive_calls != 0) + (opts.dispatch_calls != 0) + opts.throughput +
+	    !opts.scaling_threads.empty() > 1) {
+		std::cerr << "--adaptive, --dispatch, --scaling and --throughput are exclusive" << std::endl;
+		return false;
+	}
+
+	// scaling studies are about large problems (and skip the serial kernels)
+	if (!opts.scaling_threads.empty()) {
+		if (opts.size_filter.empty()) {
+			opts.size_filter = "^(large|xlarge)$";
+		}
+	}
+
+	// a handful of trials cannot make any difference significant
+	if (!opts.baseline_path.empty() && opts.trials < 5) {
+		std::cerr << "Warning: comparing " << opts.trials << " trial(s) per version, "
+		          << "use --trials=5 or more" << std::endl;
+	}
+
+	// arena pages are faulted in by the harness, before any kernel thread runs
+	if (opts.arena_size && opts.numa_policy == "first-touch") {
+		std::cerr << "--arena cannot place pages by --numa=first-touch" << std::endl;
+		return false;
+	}
+
+	if (opts.compare_hugepages && opts.hugepages == "none") {
+		opts.hugepages = "thp";
+	}
+
+	// housekeeping defaults to whatever is left once kernels have their cpus
+	if (!opts.measure_cpus.empty() && opts.housekeeping_cpus.empty()) {
+		opts.housekeeping_cpus = cpu_list_difference(get_thread_affinity(),
+		                                             opts.measure_cpus);
+	}
+	return true;
+}
+
+std::vector<std::string> get_hugepage_variants(const harness_options_t &opts) {
+	std::vector<std::string> variants;
+	if (opts.compare_hugepages) {
+		variants.push_back("none");
+	}
+	variants.push_back(opts.hugepages);
+	return variants;
+}
+
+std::vector<std::string> get_memory_flags(const harness_options_t &opts,
+                                          const std::string &hugepages) {
+	std::vector<std::string> flags;
+	if (hugepages == "thp") {
+		flags.push_back("-DPOLYBENCH_HUGEPAGES=POLYBENCH_HUGEPAGES_THP");
+	} else if (hugepages == "2mb") {
+		flags.push_back("-DPOLYBENCH_HUGEPAGES=POLYBENCH_HUGEPAGES_2MB");
+	} else if (hugepages == "1gb") {
+		flags.push_back("-DPOLYBENCH_HUGEPAGES=POLYBENCH_HUGEPAGES_1GB");
+	}
+	if (opts.numa_policy == "local") {
+		flags.push_back("-DPOLYBENCH_NUMA_POLICY=POLYBENCH_NUMA_LOCAL");
+	} else if (opts.numa_policy == "interleave") {
+		flags.push_back("-DPOLYBENCH_NUMA_POLICY=POLYBENCH_NUMA_INTERLEAVE");
+	} else if (opts.numa_policy == "bind") {
+		flags.push_back("-DPOLYBENCH_NUMA_POLICY=POLYBENCH_NUMA_BIND");
+		flags.push_back("-DPOLYBENCH_NUMA_NODE=" + std::to_string(opts.numa_node));
+	} else if (opts.numa_policy == "first-touch") {
+		// pages are faulted in by an OpenMP loop inside polybench.c
+		flags.push_back("-DPOLYBENCH_NUMA_POLICY=POLYBENCH_NUMA_FIRST_TOUCH");
+		flags.push_back("-fopenmp");
+	}
+	return flags;
+}
+
+std::string describe_memory_options(const harness_options_t &opts,
+                                    const std::string &hugepages) {
+	std::string numa = opts.numa_policy;
+	if (numa == "bind") {
+		numa += ":" + std::to_string(opts.numa_node);
+	}
+	return "numa=" + numa + " hugepages=" + hugepages;
+}
+
+static bool matches(const std::string &filter, const std::string &text) {
+	return filter.empty() || std::regex_search(text, std::regex(filter));
+}
+
+bool is_selected(const harness_options_t &opts,
+                 const std::string &category,
+                 const std::string &kernel,
+                 const std::string &size,
+                 const std::string &data_type) {
+	return matches(opts.category_filter, category) &&
+	       matches(opts.kernel_filter, kernel) &&
+	       matches(opts.size_filter, size) &&
+	       matches(opts.type_filter, data_type);
+}
@@ -0,0 +1,74 @@
+#ifndef _OPTIONS_HPP_
+#define _OPTIONS_HPP_
+
+#include "affinity.hpp"
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+// command line configuration of the test harness
+typedef struct ho_t {
+	cpu_list_t measure_cpus;      // where kernels run (empty: unconstrained)
+	cpu_list_t housekeeping_cpus; // where compilers and the harness run
+	bool check_isolation;         // warn when measure_cpus are not isolated
+	bool throughput;              // run independent versions concurrently
+	size_t worker_group_size;     // cpus per throughput worker (0: LLC slice)
+	bool interference;            // co-schedule throughput workers on one slice
+	std::string numa_policy;      // default, local, interleave, bind, first-touch
+	int numa_node;                // node of the bind policy
+	std::string hugepages;        // none, thp, 2mb, 1gb
+	bool compare_hugepages;       // build each version with 4K and huge pages
+	size_t arena_size;            // bytes of the pre-faulted arena (0: none)
+	std::vector<int> padding_factors;        // POLYBENCH_PADDING_FACTOR sweep
+	std::vector<std::string> inter_paddings; // inter-array factors or a:b:c offsets
+	unsigned int trials;          // kernel runs per version
+	std::string store_path;       // result store to append to (empty: none)
+	std::string show_store;       // result store to print instead of running
+	std::string baseline_path;    // result store to compare the sweep with
+	double threshold;             // relative slowdown tolerated by the comparison
+	std::string verdict_path;     // comparison records (empty: stdout only)
+	std::string kernel_filter;    // regular expressions selecting the versions
+	std::string category_filter;  // to run (empty: everything)
+	std::string size_filter;
+	std::string type_filter;
+	std::string checkpoint_path;  // completed versions, to resume a sweep
+	size_t keep_versions;         // versions left loaded after their run
+	unsigned int adaptive_calls;  // live calls of adaptive execution (0: off)
+	std::vector<std::string> adaptive_flags; // extra flags of each candidate
+	unsigned int dispatch_calls;  // mixed-size workload of size dispatch (0: off)
+	std::vector<unsigned int> scaling_threads; // thread counts of the scaling study (empty: off)
+	std::vector<std::string> extra_flags;    // appended to the options of every version
+	bool remarks;                 // harvest vectorizer remarks of every version
+	bool validate;                // check optimized kernels against their reference
+	double tolerance;             // error tolerated by the validation
+	bool help;                    // usage requested: printed, nothing to run
+} harness_options_t;
+
+// fills opts from argv. Returns false (after printing the reason) when the
+// harness should not run, which is not an error with opts.help.
+bool parse_harness_options(int argc, char const *argv[], harness_options_t &opts);
+
+// huge page modes every version is built with: the selected one, preceded
+// by "none" when comparing against 4K pages
+std::vector<std::string> get_hugepage_variants(const harness_options_t &opts);
+
+// compiler flags selecting the allocation policies in polybench.c
+std::vector<std::string> get_memory_flags(const harness_options_t &opts,
+                                          const std::string &hugepages);
+
+// allocation policies, as reported with every result
+std::string describe_memory_options(const harness_options_t &opts,
+                                    const std::string &hugepages);
+
+// whether the filters of opts select this version
+bool is_selected(const harness_options_t &opts,
+                 const std::string &category,
+                 const std::string &kernel,
+                 const std::string &size,
+                 const std::string &data_type);
+
+void print_harness_usage(const std::string &exe_name);
+
+#endif /* end of include guard: _OPTIONS_HPP_ */
@@ -0,0 +1,68 @@
+#include "padding.hpp"
+
+#include <algorithm>
+
+std::vector<layout_variant_t> get_layout_variants(const harness_options_t &opts) {
+	std::vector<layout_variant_t> variants;
+	if (opts.padding_factors.empty() && opts.inter_paddings.empty()) {
+		variants.push_back(layout_variant_t());
+		return variants;
+	}
+	const std::vector<int> pads = opts.padding_factors.empty() ?
+	                              std::vector<int>(1, 0) : opts.padding_factors;
+	const std::vector<std::string> inters = opts.inter_paddings.empty() ?
+	                                        std::vector<std::string>(1, "0") :
+	                                        opts.inter_paddings;
+	for (const int pad : pads) {
+		for (const auto &inter : inters) {
+			layout_variant_t v;
+			v.label = "pad=" + std::to_string(pad) + " inter=" + inter;
+			if (pad != 0) {
+				v.flags.push_back("-DPOLYBENCH_PADDING_FACTOR=" + std::to_string(pad));
+			}
+			if (inter.find(':') != std::string::npos) {
+				// explicit per-array offsets, in allocation order
+				std::string offsets = inter;
+				std::replace(offsets.begin(), offsets.end(), ':', ',');
+				v.flags.push_back("-DPOLYBENCH_INTER_ARRAY_PADDING_OFFSETS=" + offsets);
+			} else if (inter != "0") {
+				v.flags.push_back("-DPOLYBENCH_INTER_ARRAY_PADDING_FACTOR=" + inter);
+			}
+			variants.push_back(v);
+		}
+	}
+	return variants;
+}
+
+void PaddingReport::add(const run_element_t &job, const run_result_t &res) {
+	if (!res.ok) {
+		return;
+	}
+	const std::string key = job.category + " " + job.kernel + " - " + job.size +
+	                        " - " + job.data_type + " - " + job.memory;
+	std::lock_guard<std::mutex> lock(_mtx);
+	_results[key].push_back({job.layout, res.elapsed});
+}
+
+void PaddingReport::print(std::ostream &out) const {
+	std::lock_guard<std::mutex> lock(_mtx);
+	for (const auto &r : _results) {
+		const auto best = std::min_element(r.second.begin(), r.second.end(),
+		                                   [](const entry_t &a, const entry_t &b) {
+		                                   	return a.elapsed < b.elapsed;
+		                                   });
+		out << "padding best " << r.first << ": " << best->layout
+		    << " " << best->elapsed;
+		// only a sweep listing 0 in both lists has an unpadded run to compare with
+		const auto unpadded = std::find_if(r.second.begin(), r.second.end(),
+		                                   [](const entry_t &e) {
+		                                   	return e.layout == "pad=0 inter=0";
+		                                   });
+		if (unpadded == r.second.end()) {
+			out << " (no unpadded run)";
+		} else if (best->elapsed > 0) {
+			out << " (speedup " << unpadded->elapsed / best->elapsed << " over no padding)";
+		}
+		out << std::endl;
+	}
+}
@@ -0,0 +1,39 @@
+#ifndef _PADDING_HPP_
+#define _PADDING_HPP_
+
+#include "options.hpp"
+#include "runner.hpp"
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// one data layout of the padding exploration
+typedef struct lv_t {
+	std::string label;               // e.g. "pad=4 inter=64", empty by default
+	std::vector<std::string> flags;  // PolyBench padding macros
+} layout_variant_t;
+
+// cross product of --padding and --inter-padding, or the default layout
+std::vector<layout_variant_t> get_layout_variants(const harness_options_t &opts);
+
+// Collects the results of the padding exploration and reports the best
+// layout for every kernel, size, data type and memory setup.
+class PaddingReport {
+ public:
+	void add(const run_element_t &job, const run_result_t &res);
+	void print(std::ostream &out) const;
+
+ private:
+	typedef struct pe_t {
+		std::string layout;
+		double elapsed;
+	} entry_t;
+
+	mutable std::mutex _mtx;
+	std::map<std::string, std::vector<entry_t> > _results;
+};
+
+#endif /* end of include guard: _PADDING_HPP_ */
@@ -0,0 +1,168 @@
+#include "remarks.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <stdlib.h>
+
+vc::Option get_remarks_option(const std::string &path, bool clang) {
+	if (clang) {
+		return vc::Option(REMARKS_OPTION_TAG, "-foptimization-record-file=", path);
+	}
+	return vc::Option(REMARKS_OPTION_TAG, "-fopt-info-vec-all=", path);
+}
+
+static std::string get_basename(const std::string &path) {
+	const size_t slash = path.rfind('/');
+	return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+bool get_scop_lines(const std::string &source, int &first, int &last) {
+	std::ifstream in(source);
+	std::string line;
+	first = last = 0;
+	for (int n = 1; std::getline(in, line); n++) {
+		if (line.find("#pragma scop") != std::string::npos) {
+			first = n;
+		} else if (line.find("#pragma endscop") != std::string::npos) {
+			last = n;
+		}
+	}
+	return first > 0 && last > first;
+}
+
+// "gemm.c:93:22: optimized: loop vectorized using 32 byte vectors"
+static bool parse_gcc_remark(const std::string &text, std::string &file, remark_t &r) {
+	const size_t c1 = text.find(':');
+	const size_t c2 = text.find(':', c1 + 1);
+	const size_t c3 = text.find(':', c2 + 1);
+	const size_t c4 = text.find(": ", c3 + 1);
+	if (c4 == std::string::npos) {
+		return false;
+	}
+	file = text.substr(0, c1);
+	r.line = atoi(text.substr(c1 + 1, c2 - c1 - 1).c_str());
+	r.kind = text.substr(c3 + 2, c4 - c3 - 2);
+	// the message may be empty
+	const size_t message = text.find_first_not_of(' ', c4 + 2);
+	r.message = message == std::string::npos ? "" : text.substr(message);
+	return r.line > 0;
+}
+
+// value of "key: value" in a line of an optimization record
+static std::string get_yaml_field(const std::string &text, const std::string &key) {
+	const size_t k = text.find(key + ":");
+	if (k == std::string::npos) {
+		return "";
+	}
+	const size_t begin = text.find_first_not_of(' ', k + key.size() + 1);
+	const size_t end = text.find_first_of(",}", begin);
+	std::string value = text.substr(begin, end == std::string::npos ? end : end - begin);
+	while (!value.empty() && (value.back() == ' ' || value.back() == '\'')) {
+		value.pop_back();
+	}
+	return value.empty() || value[0] != '\'' ? value : value.substr(1);
+}
+
+// value of an argument of a clang remark ("  - String: 'loop not vectorized: '"),
+// quotes and inner spaces of the strings kept as the compiler wrote them
+static std::string get_yaml_arg(const std::string &text) {
+	const size_t colon = text.find(':');
+	const size_t begin = colon == std::string::npos ? colon
+	                                                : text.find_first_not_of(' ', colon + 1);
+	if (begin == std::string::npos) {
+		return "";
+	}
+	std::string value = text.substr(begin);
+	if (value.size() >= 2 && value[0] == '\'' && value.back() == '\'') {
+		value = value.substr(1, value.size() - 2);
+		// '' is a quote in a single-quoted YAML string
+		for (size_t q = value.find("''"); q != std::string::npos; q = value.find("''", q + 1)) {
+			value.erase(q, 1);
+		}
+	}
+	return value;
+}
+
+std::vector<remark_t> load_remarks(const std::string &path, const std::string &source) {
+	std::vector<remark_t> remarks;
+	int first = 0, last = 0;
+	if (!get_scop_lines(source, first, last)) {
+		return remarks;
+	}
+	const std::string source_name = get_basename(source);
+	std::ifstream in(path);
+	std::string text;
+	const bool clang = in.peek() == '-';
+	// clang records span several lines: --- !Passed, Pass:, Name:, DebugLoc:,
+	// then Args: whose strings make up the message (the reason of a miss is
+	// given by the Analysis records)
+	remark_t r;
+	std::string file, pass, name, args;
+	const auto keep = [&]() {
+		if (get_basename(file) == source_name && r.line >= first && r.line <= last) {
+			remarks.push_back(r);
+		}
+	};
+	while (std::getline(in, text)) {
+		if (!clang) {
+			if (parse_gcc_remark(text, file, r)) {
+				keep();
+			}
+		} else if (text.compare(0, 5, "--- !") == 0) {
+			if (pass.find("vectorize") != std::string::npos) {
+				r.message = args.empty() ? name : args;
+				keep();
+			}
+			const std::string kind = text.substr(5);
+			r = remark_t();
+			r.kind = kind == "Passed" ? "optimized" :
+			         kind == "Missed" || kind.compare(0, 8, "Analysis") == 0 ? "missed" : "note";
+			file.clear();
+			pass.clear();
+			name.clear();
+			args.clear();
+		} else if (text.compare(0, 5, "Pass:") == 0) {
+			pass = get_yaml_field(text, "Pass");
+		} else if (text.compare(0, 5, "Name:") == 0) {
+			name = get_yaml_field(text, "Name");
+		} else if (text.compare(0, 4, "  - ") == 0) {
+			args += get_yaml_arg(text);
+		} else if (text.compare(0, 9, "DebugLoc:") == 0) {
+			file = get_yaml_field(text, "File");
+			r.line = atoi(get_yaml_field(text, "Line").c_str());
+		}
+	}
+	if (clang && pass.find("vectorize") != std::string::npos) {
+		r.message = args.empty() ? name : args;
+		keep();
+	}
+	std::stable_sort(remarks.begin(), remarks.end(),
+	                 [](const remark_t &a, const remark_t &b) { return a.line < b.line; });
+	return remarks;
+}
+
+std::string describe_remarks(const std::vector<remark_t> &remarks) {
+	// the first "not vectorized" reason is the most useful one
+	std::map<int, std::string> loops;
+	for (const auto &r : remarks) {
+		std::string &verdict = loops[r.line];
+		// gcc says "loop vectorized using ...", clang "Vectorized"
+		if (r.kind == "optimized" && r.message.find("ectorized") != std::string::npos) {
+			verdict = "vectorized (" + r.message + ")";
+		} else if (r.kind == "missed" && verdict.compare(0, 10, "vectorized") != 0 &&
+		           (verdict.empty() || verdict == "missed")) {
+			const size_t reason = r.message.find("not vectorized: ");
+			verdict = reason == std::string::npos ? "missed"
+			                                      : "missed (" + r.message.substr(reason + 16) + ")";
+		}
+	}
+	std::string res;
+	for (const auto &l : loops) {
+		if (!l.second.empty()) {
+			res += (res.empty() ? "" : "; ") + std::string("L") + std::to_string(l.first) +
+			       " " + l.second;
+		}
+	}
+	return res.empty() ? "no loop remark" : res;
+}
@@ -0,0 +1,32 @@
+#ifndef _REMARKS_HPP_
+#define _REMARKS_HPP_
+
+#include "versioningCompiler/Option.hpp"
+
+#include <string>
+#include <vector>
+
+// one vectorizer remark on the #pragma scop region of a kernel
+typedef struct vr_t {
+	int line;             // in the kernel source file
+	std::string kind;     // optimized, missed or note
+	std::string message;
+} remark_t;
+
+// tag of the remark option, replaced when a version is derived
+#define REMARKS_OPTION_TAG "remarks"
+
+// asks the compiler to write its vectorizer remarks to path: gcc text
+// (-fopt-info-vec-all) or clang YAML (-foptimization-record-file)
+vc::Option get_remarks_option(const std::string &path, bool clang);
+
+// lines of #pragma scop and #pragma endscop in source (0 when missing)
+bool get_scop_lines(const std::string &source, int &first, int &last);
+
+// remarks of path (either format) on the scop region of source, by line
+std::vector<remark_t> load_remarks(const std::string &path, const std::string &source);
+
+// per loop line: vectorized, or missed with the reason given
+std::string describe_remarks(const std::vector<remark_t> &remarks);
+
+#endif /* end of include guard: _REMARKS_HPP_ */
@@ -0,0 +1,67 @@
+#include "resources.hpp"
+
+#include <fstream>
+#include <sys/resource.h>
+#include <sys/time.h>
+
+static resource_usage_t get_rusage(bool process_wide) {
+	resource_usage_t usage;
+	usage.rss_peak_kb = -1;
+	struct rusage ru;
+	if (getrusage(process_wide ? RUSAGE_SELF : RUSAGE_THREAD, &ru) != 0) {
+		usage.minor_faults = usage.major_faults = 0;
+		usage.voluntary_switches = usage.involuntary_switches = 0;
+		return usage;
+	}
+	usage.minor_faults = ru.ru_minflt;
+	usage.major_faults = ru.ru_majflt;
+	usage.voluntary_switches = ru.ru_nvcsw;
+	usage.involuntary_switches = ru.ru_nivcsw;
+	return usage;
+}
+
+// VmHWM of /proc/self/status, in kB
+static long get_rss_peak_kb() {
+	std::ifstream status("/proc/self/status");
+	std::string key;
+	while (status >> key) {
+		if (key == "VmHWM:") {
+			long kb = -1;
+			status >> kb;
+			return kb;
+		}
+		status.ignore(4096, '\n');
+	}
+	return -1;
+}
+
+// "5" resets the peak RSS of the process to its current RSS (Linux >= 4.0)
+static bool reset_rss_peak() {
+	std::ofstream clear_refs("/proc/self/clear_refs");
+	clear_refs << "5" << std::endl;
+	return static_cast<bool>(clear_refs);
+}
+
+void ResourceMeter::start() {
+	_rss_reset = _process_wide && reset_rss_peak();
+	_start = get_rusage(_process_wide);
+}
+
+resource_usage_t ResourceMeter::stop() const {
+	resource_usage_t usage = get_rusage(_process_wide);
+	usage.minor_faults -= _start.minor_faults;
+	usage.major_faults -= _start.major_faults;
+	usage.voluntary_switches -= _start.voluntary_switches;
+	usage.involuntary_switches -= _start.involuntary_switches;
+	usage.rss_peak_kb = _rss_reset ? get_rss_peak_kb() : -1;
+	return usage;
+}
+
+std::string describe_resource_usage(const resource_usage_t &usage) {
+	return "rss_peak_kb=" + (usage.rss_peak_kb < 0 ? std::string("n/a")
+	                                               : std::to_string(usage.rss_peak_kb)) +
+	       " minflt=" + std::to_string(usage.minor_faults) +
+	       " majflt=" + std::to_string(usage.major_faults) +
+	       " nvcsw=" + std::to_string(usage.voluntary_switches) +
+	       " nivcsw=" + std::to_string(usage.involuntary_switches);
+}
@@ -0,0 +1,34 @@
+#ifndef _RESOURCES_HPP_
+#define _RESOURCES_HPP_
+
+#include <string>
+
+// operating system resources consumed by a run
+typedef struct ru_t {
+	long rss_peak_kb;          // peak resident set size (-1: unknown)
+	long minor_faults;
+	long major_faults;
+	long voluntary_switches;
+	long involuntary_switches;
+} resource_usage_t;
+
+// Measures the resources used between start() and stop().
+// Process-wide figures are only meaningful when nothing else runs in the
+// process at the same time: otherwise only the calling thread is
+// accounted and the peak RSS is unknown.
+class ResourceMeter {
+ public:
+	explicit ResourceMeter(bool process_wide) : _process_wide(process_wide) {}
+
+	void start();
+	resource_usage_t stop() const;
+
+ private:
+	bool _process_wide;
+	bool _rss_reset;
+	resource_usage_t _start;
+};
+
+std::string describe_resource_usage(const resource_usage_t &usage);
+
+#endif /* end of include guard: _RESOURCES_HPP_ */
@@ -0,0 +1,143 @@
+#include "runner.hpp"
+#include "stats.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+std::vector<std::string> get_runner_symbols(const std::string &main_name) {
+	return {
+		main_name,
+		"polybench_timer_get_elapsed",
+		"polybench_get_alloc_stats",
+		"polybench_reset_alloc_stats",
+		"polybench_set_arena",
+		"polybench_set_dump_target",
+	};
+}
+
+bool load_runner_symbols(vc::Version &version, runner_symbols_t &symbols) {
+	symbols.run = reinterpret_cast<main_signature_t*>(
+	              version.getSymbol(RUNNER_MAIN_SYMBOL));
+	symbols.elapsed = reinterpret_cast<elapsed_signature_t*>(
+	                  version.getSymbol(RUNNER_ELAPSED_SYMBOL));
+	symbols.alloc_stats = reinterpret_cast<alloc_stats_signature_t*>(
+	                      version.getSymbol(RUNNER_ALLOC_STATS_SYMBOL));
+	symbols.reset_alloc_stats = reinterpret_cast<reset_alloc_stats_signature_t*>(
+	                            version.getSymbol(RUNNER_RESET_ALLOC_STATS_SYMBOL));
+	symbols.set_arena = reinterpret_cast<set_arena_signature_t*>(
+	                    version.getSymbol(RUNNER_SET_ARENA_SYMBOL));
+	symbols.set_dump_target = reinterpret_cast<set_dump_target_signature_t*>(
+	                          version.getSymbol(RUNNER_SET_DUMP_TARGET_SYMBOL));
+	return symbols.run != nullptr;
+}
+
+std::string describe_alloc_stats(const alloc_stats_t &stats) {
+	return "alloc_peak=" + std::to_string(stats.peak_bytes) +
+	       " alloc_total=" + std::to_string(stats.total_bytes) +
+	       " allocs=" + std::to_string(stats.nb_allocs) +
+	       " leaked=" + std::to_string(stats.live_bytes);
+}
+
+// runs job and its reference once more, with print_array enabled
+static bool validate_job(const run_element_t &job,
+                         const runner_symbols_t &sym,
+                         double tolerance,
+                         validation_t &validation) {
+	if (!job.reference->compile()) {
+		std::cerr << "Error while compiling the reference of " << job.label << std::endl;
+		return false;
+	}
+	runner_symbols_t ref;
+	std::vector<double> values, reference;
+	// outside the arena and the measure cpus: only the output matters
+	bool ok = load_runner_symbols(*job.reference, ref) &&
+	          capture_dump(sym.run, sym.set_dump_target, values) &&
+	          capture_dump(ref.run, ref.set_dump_target, reference);
+	// only needed once
+	job.reference->fold();
+	if (!ok) {
+		std::cerr << "Error while dumping the output of " << job.label << std::endl;
+		return false;
+	}
+	validation = compare_dumps(values, reference, tolerance);
+	if (!validation.passed) {
+		std::cerr << "Error while validating " << job.label << ": "
+		          << describe_validation(validation) << std::endl;
+	}
+	return validation.passed;
+}
+
+const Arena *get_arena(const run_config_t &cfg, const run_element_t &job) {
+	const Arena *arena = (job.pages == "none" && cfg.small_page_arena) ?
+	                     cfg.small_page_arena : cfg.arena;
+	return (arena && arena->data()) ? arena : nullptr;
+}
+
+run_result_t run_job(const run_element_t &job, const run_config_t &cfg) {
+	run_result_t res;
+	res.ok = false;
+	res.elapsed = 0;
+	res.placement.last_cpu = -1;
+	res.placement.isolated = false;
+	res.placement.nohz_full = false;
+	res.alloc = alloc_stats_t();
+	res.usage = resource_usage_t();
+	res.usage.rss_peak_kb = -1;
+	res.validation = validation_t();
+
+	// compilers inherit the mask of the calling thread
+	if (!cfg.compile_cpus.empty()) {
+		pin_current_thread(cfg.compile_cpus);
+	}
+	bool ok = job.version->compile();
+	if (!ok) {
+		std::cerr << "Error while compiling " << job.label << std::endl;
+		return res;
+	}
+	if (!job.remarks_file.empty()) {
+		res.remarks = load_remarks(job.remarks_file, job.source_file);
+	}
+	runner_symbols_t sym;
+	if (!load_runner_symbols(*job.version, sym)) {
+		std::cerr << "Error while loading " << job.label << std::endl;
+		return res;
+	}
+
+	char* runningArgv[] = { nullptr };
+	const Arena *arena = get_arena(cfg, job);
+	ResourceMeter meter(cfg.exclusive);
+	for (unsigned int t = 0; t < std::max(cfg.trials, 1u); t++) {
+		if (sym.reset_alloc_stats) {
+			sym.reset_alloc_stats();
+		}
+		if (arena && sym.set_arena) {
+			sym.set_arena(arena->data(), arena->size());
+		}
+		// only the kernel moves onto the measurement cpus
+		if (!cfg.run_cpus.empty() && !pin_current_thread(cfg.run_cpus)) {
+			std::cerr << "Error while pinning " << job.label << std::endl;
+		}
+		meter.start();
+		sym.run(0, runningArgv);
+		res.usage = meter.stop();
+		res.placement = get_current_placement();
+		if (!cfg.compile_cpus.empty()) {
+			pin_current_thread(cfg.compile_cpus);
+		}
+		res.trials.push_back(sym.elapsed ? sym.elapsed() : 0);
+		if (sym.alloc_stats) {
+			sym.alloc_stats(&res.alloc);
+		}
+	}
+	if (arena && sym.set_arena) {
+		// the arena outlives the version: do not leave it dangling there
+		sym.set_arena(nullptr, 0);
+	}
+
+	res.elapsed = median(res.trials);
+	res.ok = true;
+	if (job.reference) {
+		res.ok = validate_job(job, sym, cfg.tolerance, res.validation);
+	}
+	return res;
+}
@@ -0,0 +1,114 @@
+#ifndef _RUNNER_HPP_
+#define _RUNNER_HPP_
+
+#include "versioningCompiler/Version.hpp"
+#include "affinity.hpp"
+#include "arena.hpp"
+#include "remarks.hpp"
+#include "resources.hpp"
+#include "validate.hpp"
+
+#include <stdio.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// one version of the sweep, with what it was built from
+typedef struct re_t {
+	std::string label;     // human readable summary of the fields below
+	std::string category;
+	std::string kernel;
+	std::string size;
+	std::string data_type;
+	std::string memory;    // allocation policies, see describe_memory_options
+	std::string pages;     // huge page mode, see get_hugepage_variants
+	std::string layout;    // padding of the arrays, see get_layout_variants
+	std::string compiler;  // compiler identity and version
+	std::string options;   // command line options of the version
+	std::string source_file;   // kernel source
+	std::string remarks_file;  // where the compiler writes its remarks (empty: none)
+	std::shared_ptr<vc::Version> version;
+	std::shared_ptr<vc::Version> reference; // output to validate against (null: none)
+	std::string reference_kernel;  // label of the kernel this one is a variant of
+	bool parallel;         // see kernel_descriptor_t
+	int work_exponent;
+} run_element_t;
+typedef int (main_signature_t)(int argc, char*argv[]);
+typedef double (elapsed_signature_t)();
+
+// mirrors struct polybench_alloc_stats of polybench.h
+typedef struct as_t {
+	unsigned long long nb_allocs;
+	unsigned long long nb_live;
+	unsigned long long live_bytes;
+	unsigned long long peak_bytes;
+	unsigned long long total_bytes;
+} alloc_stats_t;
+typedef void (alloc_stats_signature_t)(alloc_stats_t *stats);
+typedef void (reset_alloc_stats_signature_t)();
+typedef void (set_arena_signature_t)(void *base, size_t size);
+typedef void (set_dump_target_signature_t)(FILE *target);
+
+// position of the symbols in the function name list of every version
+#define RUNNER_MAIN_SYMBOL 0
+#define RUNNER_ELAPSED_SYMBOL 1
+#define RUNNER_ALLOC_STATS_SYMBOL 2
+#define RUNNER_RESET_ALLOC_STATS_SYMBOL 3
+#define RUNNER_SET_ARENA_SYMBOL 4
+#define RUNNER_SET_DUMP_TARGET_SYMBOL 5
+
+// function name list for a version whose entry point is main_name
+std::vector<std::string> get_runner_symbols(const std::string &main_name);
+
+// entry points of a compiled version, nullptr when missing
+typedef struct rs_t {
+	main_signature_t *run;
+	elapsed_signature_t *elapsed;
+	alloc_stats_signature_t *alloc_stats;
+	reset_alloc_stats_signature_t *reset_alloc_stats;
+	set_arena_signature_t *set_arena;
+	set_dump_target_signature_t *set_dump_target;
+} runner_symbols_t;
+
+// false when the entry point itself is missing
+bool load_runner_symbols(vc::Version &version, runner_symbols_t &symbols);
+
+typedef struct rr_t {
+	bool ok;                     // compiled, loaded and executed
+	double elapsed;              // median of the trials
+	std::vector<double> trials;  // PolyBench timer of the kernel region, per run
+	placement_t placement;       // where the last trial ran
+	alloc_stats_t alloc;         // polybench_alloc_data accounting of the last trial
+	resource_usage_t usage;      // faults, context switches and peak RSS of the last trial
+	std::vector<remark_t> remarks; // vectorizer remarks on the scop region
+	validation_t validation;     // output compared with the one of job.reference
+} run_result_t;
+
+// how to execute a job
+typedef struct rc_t {
+	cpu_list_t compile_cpus; // where compilers run (empty: anywhere)
+	cpu_list_t run_cpus;     // where the kernel runs (empty: anywhere)
+	const Arena *arena;      // source of the kernel arrays, reset every trial
+	const Arena *small_page_arena; // replaces arena for the 4K page versions when
+	                               // arena is huge page backed (null: none)
+	unsigned int trials;     // runs of the kernel after one compilation
+	bool exclusive;          // no other job runs in the process meanwhile, so that
+	                         // process-wide usage (OpenMP teams, peak RSS) is its own
+	double tolerance;        // of the validation against job.reference
+} run_config_t;
+
+// called with every result, concurrently by the workers in throughput mode
+typedef std::function<void(const run_element_t &job, const run_result_t &res)> result_handler_t;
+
+std::string describe_alloc_stats(const alloc_stats_t &stats);
+
+// arena of cfg matching the page mode of job, null when there is none to hand
+const Arena *get_arena(const run_config_t &cfg, const run_element_t &job);
+
+// compiles job, then runs it cfg.trials times. With a reference, the output
+// of one more run is then validated against it; a mismatch fails the job.
+run_result_t run_job(const run_element_t &job, const run_config_t &cfg);
+
+#endif /* end of include guard: _RUNNER_HPP_ */
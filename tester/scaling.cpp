@@ -0,0 +1,170 @@
+#include "scaling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+dataset_dims_t get_dataset_dims(const std::string &source_file, const std::string &dataset) {
+	dataset_dims_t dims;
+	const std::string dir = source_file.substr(0, source_file.rfind('/') + 1);
+	std::ifstream source(source_file);
+	std::string line, header;
+	while (header.empty() && std::getline(source, line)) {
+		const size_t open = line.find("#include \"");
+		if (open != std::string::npos) {
+			header = line.substr(open + 10, line.find('"', open + 10) - open - 10);
+		}
+	}
+	std::ifstream in(dir + header);
+	bool inside = false;
+	while (!header.empty() && std::getline(in, line)) {
+		std::istringstream ss(line);
+		std::string directive, name;
+		long value;
+		ss >> directive;
+		// "#  ifdef X" or "#ifdef X"
+		if (directive == "#") {
+			ss >> directive;
+			directive = "#" + directive;
+		}
+		if (directive == "#ifdef") {
+			ss >> name;
+			inside = name == dataset;
+		} else if (directive == "#endif") {
+			if (inside) {
+				break;
+			}
+		} else if (inside && directive == "#define" && ss >> name >> value) {
+			dims.push_back(std::make_pair(name, value));
+		}
+	}
+	return dims;
+}
+
+// the dataset macro of a version, e.g. LARGE_DATASET
+static std::string get_dataset(const run_element_t &job) {
+	std::istringstream ss(job.options);
+	std::string option;
+	while (ss >> option) {
+		const std::string suffix = "_DATASET";
+		if (option.compare(0, 2, "-D") == 0 && option.size() > suffix.size() + 2 &&
+		    option.compare(option.size() - suffix.size(), suffix.size(), suffix) == 0) {
+			return option.substr(2);
+		}
+	}
+	return "";
+}
+
+// strong or weak run of one thread count
+typedef struct sr_t {
+	run_element_t job;
+	run_result_t res;
+} scaling_run_t;
+
+size_t run_scaling(JobGenerator &jobs,
+                   const harness_options_t &opts,
+                   const run_config_t &cfg,
+                   const result_handler_t &on_result) {
+	std::vector<unsigned int> threads = opts.scaling_threads;
+	threads.push_back(1);
+	std::sort(threads.begin(), threads.end());
+	threads.erase(std::unique(threads.begin(), threads.end()), threads.end());
+	const size_t cpus = cfg.run_cpus.empty() ? get_thread_affinity().size()
+	                                         : cfg.run_cpus.size();
+	if (threads.back() > cpus) {
+		std::cerr << "Warning: up to " << threads.back() << " threads on " << cpus
+		          << " cpus, the last runs are oversubscribed" << std::endl;
+	}
+
+	size_t failed = 0;
+	run_element_t j;
+	while (jobs.next(j)) {
+		// only the variants registered as parallel use the thread count
+		// (-fopenmp may be added to serial kernels, e.g. by --numa=first-touch)
+		if (!j.parallel) {
+			continue;
+		}
+		std::cout << "working on " << j.label << std::endl;
+		dataset_dims_t dims;
+		if (j.work_exponent > 0) {
+			dims = get_dataset_dims(j.source_file, get_dataset(j));
+			if (dims.empty()) {
+				std::cerr << "Error while reading the dimensions of " << j.label
+				          << ", no weak scaling" << std::endl;
+			}
+		}
+		std::vector<scaling_run_t> strong, weak;
+		for (const unsigned int n : threads) {
+			const std::string flags = "-DPOLYBENCH_THREADS=" + std::to_string(n);
+			scaling_run_t s;
+			s.job = make_variant(j, flags);
+			if (n == threads.back()) {
+				s.job.reference = j.reference;
+			}
+			s.res = run_job(s.job, cfg);
+			strong.push_back(s);
+
+			// one thread: the same problem as strong scaling
+			if (n == 1 || dims.empty()) {
+				weak.push_back(s);
+				continue;
+			}
+			std::string weak_flags = flags;
+			// n times the work of one thread
+			const double factor = std::pow(static_cast<double>(n), 1.0 / j.work_exponent);
+			for (const auto &d : dims) {
+				weak_flags += " -D" + d.first + "=" +
+				              std::to_string(std::lround(d.second * factor));
+			}
+			scaling_run_t w;
+			w.job = make_variant(j, weak_flags);
+			w.res = run_job(w.job, cfg);
+			weak.push_back(w);
+		}
+
+		const double t1 = strong.front().res.ok ? strong.front().res.elapsed : 0;
+		for (size_t t = 0; t < threads.size(); t++) {
+			const scaling_run_t &s = strong[t];
+			const scaling_run_t &w = weak[t];
+			std::cout << "scaling " << j.label << " threads=" << threads[t];
+			if (s.res.ok && s.res.elapsed > 0 && t1 > 0) {
+				const double speedup = t1 / s.res.elapsed;
+				std::cout << " strong=" << s.res.elapsed << " s speedup=" << speedup
+				          << " efficiency=" << speedup / threads[t];
+			} else {
+				std::cout << " strong=failed";
+			}
+			if (dims.empty()) {
+				std::cout << std::endl;
+				continue;
+			}
+			if (w.res.ok && w.res.elapsed > 0 && t1 > 0) {
+				std::cout << " weak=" << w.res.elapsed << " s efficiency="
+				          << t1 / w.res.elapsed << std::endl;
+			} else {
+				std::cout << " weak=failed" << std::endl;
+			}
+		}
+		if (strong.back().res.validation.checked) {
+			std::cout << "validation " << strong.back().job.label << ": "
+			          << describe_validation(strong.back().res.validation) << std::endl;
+		}
+
+		for (size_t t = 0; t < threads.size(); t++) {
+			failed += !strong[t].res.ok;
+			if (on_result) {
+				on_result(strong[t].job, strong[t].res);
+			}
+			if (threads[t] == 1 || dims.empty()) {
+				continue;
+			}
+			failed += !weak[t].res.ok;
+			if (on_result) {
+				on_result(weak[t].job, weak[t].res);
+			}
+		}
+	}
+	return failed;
+}
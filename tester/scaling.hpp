@@ -0,0 +1,34 @@
+#ifndef _SCALING_HPP_
+#define _SCALING_HPP_
+
+#include "options.hpp"
+#include "runner.hpp"
+#include "sweep.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef std::vector<std::pair<std::string, long> > dataset_dims_t;
+
+// problem dimensions (e.g. NI=1000, NJ=1100, NK=1200) that the header
+// included by a kernel source defines for a dataset macro such as
+// LARGE_DATASET, empty when not found
+dataset_dims_t get_dataset_dims(const std::string &source_file, const std::string &dataset);
+
+// Strong and weak scaling of every parallel version of jobs (registered
+// with kernel_descriptor_t::parallel) over the thread counts of
+// opts.scaling_threads, set at build time with -DPOLYBENCH_THREADS.
+// Strong scaling keeps the problem of the version; weak scaling multiplies
+// every dimension by the root of the thread count of degree work_exponent
+// (the cubic root for matrix products), so that the work grows with the
+// threads, and is skipped when work_exponent is 0. Speedups and
+// efficiencies are relative to one thread; the variant with the most threads is validated
+// when the version has a reference. Every run is passed to on_result.
+// Returns the number of failures.
+size_t run_scaling(JobGenerator &jobs,
+                   const harness_options_t &opts,
+                   const run_config_t &cfg,
+                   const result_handler_t &on_result = nullptr);
+
+#endif /* end of include guard: _SCALING_HPP_ */
@@ -0,0 +1,89 @@
+#include "stats.hpp"
+
+#include <algorithm>
+#include <math.h>
+#include <random>
+
+double median(std::vector<double> samples) {
+	if (samples.empty()) {
+		return 0;
+	}
+	std::sort(samples.begin(), samples.end());
+	const size_t n = samples.size();
+	return (n % 2) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+}
+
+double mann_whitney_p(const std::vector<double> &a, const std::vector<double> &b) {
+	const double n1 = a.size(), n2 = b.size(), n = n1 + n2;
+	if (a.empty() || b.empty()) {
+		return 1;
+	}
+	// rank the pooled samples, ties get their average rank
+	std::vector<std::pair<double, bool> > pooled;
+	for (const double x : a) {
+		pooled.push_back(std::make_pair(x, true));
+	}
+	for (const double x : b) {
+		pooled.push_back(std::make_pair(x, false));
+	}
+	std::sort(pooled.begin(), pooled.end());
+	double rank_sum_a = 0, ties = 0;
+	for (size_t i = 0; i < pooled.size(); ) {
+		size_t j = i;
+		while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+			j++;
+		}
+		const double t = j - i;
+		const double rank = (i + 1 + j) / 2.0;
+		for (size_t k = i; k < j; k++) {
+			if (pooled[k].second) {
+				rank_sum_a += rank;
+			}
+		}
+		ties += t * t * t - t;
+		i = j;
+	}
+	const double u = rank_sum_a - n1 * (n1 + 1) / 2;
+	const double mu = n1 * n2 / 2;
+	const double sigma = sqrt(n1 * n2 / 12 * ((n + 1) - ties / (n * (n - 1))));
+	if (sigma == 0) {
+		return 1;
+	}
+	const double z = std::max(fabs(u - mu) - 0.5, 0.0) / sigma;
+	return erfc(z / sqrt(2.0));
+}
+
+void bootstrap_median_ratio_ci(const std::vector<double> &a,
+                               const std::vector<double> &b,
+                               double level,
+                               unsigned int resamples,
+                               double &low,
+                               double &high) {
+	low = high = 0;
+	if (a.empty() || b.empty() || resamples == 0) {
+		return;
+	}
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<size_t> pick_a(0, a.size() - 1);
+	std::uniform_int_distribution<size_t> pick_b(0, b.size() - 1);
+	std::vector<double> ratios, ra(a.size()), rb(b.size());
+	for (unsigned int r = 0; r < resamples; r++) {
+		for (auto &x : ra) {
+			x = a[pick_a(gen)];
+		}
+		for (auto &x : rb) {
+			x = b[pick_b(gen)];
+		}
+		const double ma = median(ra);
+		if (ma > 0) {
+			ratios.push_back(median(rb) / ma);
+		}
+	}
+	if (ratios.empty()) {
+		return;
+	}
+	std::sort(ratios.begin(), ratios.end());
+	const double tail = (1 - level) / 2;
+	low = ratios[static_cast<size_t>(tail * (ratios.size() - 1))];
+	high = ratios[static_cast<size_t>((1 - tail) * (ratios.size() - 1))];
+}
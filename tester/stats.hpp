@@ -0,0 +1,23 @@
+#ifndef _STATS_HPP_
+#define _STATS_HPP_
+
+#include <vector>
+
+// median of samples (0 when empty)
+double median(std::vector<double> samples);
+
+// Two-sided p-value of the Mann-Whitney U test that a and b come from the
+// same distribution (normal approximation with tie and continuity
+// corrections). 1 when either sample is empty.
+double mann_whitney_p(const std::vector<double> &a, const std::vector<double> &b);
+
+// Percentile bootstrap confidence interval of median(b) / median(a), with a
+// fixed seed so that verdicts are reproducible.
+void bootstrap_median_ratio_ci(const std::vector<double> &a,
+                               const std::vector<double> &b,
+                               double level,
+                               unsigned int resamples,
+                               double &low,
+                               double &high);
+
+#endif /* end of include guard: _STATS_HPP_ */
@@ -0,0 +1,226 @@
+#include "store.hpp"
+
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdio.h>
+#include <sys/utsname.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef TESTER_SOURCE_DIRECTORY
+#define TESTER_SOURCE_DIRECTORY "."
+#endif
+
+// tabs and newlines separate fields and records
+static std::string escape_field(const std::string &text) {
+	std::string res;
+	for (const char c : text) {
+		switch (c) {
+			case '\\': res += "\\\\"; break;
+			case '\t': res += "\\t"; break;
+			case '\n': res += "\\n"; break;
+			default: res += c; break;
+		}
+	}
+	return res;
+}
+
+static std::string unescape_field(const std::string &text) {
+	std::string res;
+	for (size_t i = 0; i < text.size(); i++) {
+		if (text[i] == '\\' && i + 1 < text.size()) {
+			i++;
+			res += (text[i] == 't') ? '\t' : (text[i] == 'n') ? '\n' : text[i];
+		} else {
+			res += text[i];
+		}
+	}
+	return res;
+}
+
+static std::string get_cpu_model() {
+	std::ifstream cpuinfo("/proc/cpuinfo");
+	std::string line;
+	while (std::getline(cpuinfo, line)) {
+		if (line.compare(0, 10, "model name") == 0) {
+			const size_t colon = line.find(':');
+			if (colon != std::string::npos) {
+				return line.substr(line.find_first_not_of(' ', colon + 1));
+			}
+		}
+	}
+	return "unknown";
+}
+
+// first line printed by command, empty when it fails or prints nothing
+static std::string read_first_line(const std::string &command) {
+	std::string text;
+	FILE *out = popen(command.c_str(), "r");
+	if (!out) {
+		return text;
+	}
+	char line[256];
+	if (fgets(line, sizeof(line), out)) {
+		text = line;
+		while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) {
+			text.pop_back();
+		}
+	}
+	pclose(out);
+	return text;
+}
+
+// read at run time so stored results follow new commits without re-running
+// cmake
+static std::string get_harness_revision() {
+	const std::string revision = read_first_line(std::string("git -C '") + TESTER_SOURCE_DIRECTORY +
+	                                             "' rev-parse --short HEAD 2>/dev/null");
+	return revision.empty() ? "unknown" : revision;
+}
+
+result_record_t get_run_context() {
+	result_record_t ctx;
+	ctx["revision"] = get_harness_revision();
+	char hostname[256] = "unknown";
+	gethostname(hostname, sizeof(hostname) - 1);
+	ctx["host"] = hostname;
+	ctx["cpu"] = get_cpu_model();
+	ctx["ncpus"] = std::to_string(sysconf(_SC_NPROCESSORS_ONLN));
+	struct utsname u;
+	if (uname(&u) == 0) {
+		ctx["os"] = std::string(u.sysname) + " " + u.release + " " + u.machine;
+	}
+	char when[32] = "";
+	const time_t now = time(nullptr);
+	struct tm utc;
+	gmtime_r(&now, &utc);
+	strftime(when, sizeof(when), "%Y-%m-%dT%H:%M:%SZ", &utc);
+	ctx["started"] = when;
+	return ctx;
+}
+
+std::string get_compiler_version(const std::string &command) {
+	const std::string version = read_first_line(command + " --version 2>/dev/null");
+	return version.empty() ? command : version;
+}
+
+result_record_t make_result_record(const run_element_t &job, const run_result_t &res) {
+	result_record_t r;
+	r["status"] = res.ok ? "ok" : "failed";
+	r["category"] = job.category;
+	r["kernel"] = job.kernel;
+	r["size"] = job.size;
+	r["type"] = job.data_type;
+	r["memory"] = job.memory;
+	r["layout"] = job.layout;
+	r["compiler"] = job.compiler;
+	r["options"] = job.options;
+	if (res.validation.checked) {
+		r["validation"] = describe_validation(res.validation);
+	}
+	if (!res.ok) {
+		return r;
+	}
+	std::ostringstream trials, median;
+	trials << std::setprecision(9);
+	for (size_t t = 0; t < res.trials.size(); t++) {
+		trials << (t ? "," : "") << res.trials[t];
+	}
+	median << std::setprecision(9) << res.elapsed;
+	r["trials"] = trials.str();
+	r["median"] = median.str();
+	r["placement"] = describe_placement(res.placement);
+	r["alloc_peak"] = std::to_string(res.alloc.peak_bytes);
+	r["alloc_total"] = std::to_string(res.alloc.total_bytes);
+	r["allocs"] = std::to_string(res.alloc.nb_allocs);
+	r["leaked"] = std::to_string(res.alloc.live_bytes);
+	r["rss_peak_kb"] = std::to_string(res.usage.rss_peak_kb);
+	r["minflt"] = std::to_string(res.usage.minor_faults);
+	r["majflt"] = std::to_string(res.usage.major_faults);
+	r["nvcsw"] = std::to_string(res.usage.voluntary_switches);
+	r["nivcsw"] = std::to_string(res.usage.involuntary_switches);
+	if (!job.remarks_file.empty()) {
+		std::string remarks;
+		for (const auto &rem : res.remarks) {
+			remarks += (remarks.empty() ? "" : "|") + std::to_string(rem.line) + ":" +
+			           rem.kind + ":" + rem.message;
+		}
+		r["remarks"] = remarks;
+		r["vectorization"] = describe_remarks(res.remarks);
+	}
+	return r;
+}
+
+std::string format_result_record(const result_record_t &record) {
+	std::string line;
+	for (const auto &f : record) {
+		line += (line.empty() ? "" : "\t") + escape_field(f.first) + "=" + escape_field(f.second);
+	}
+	return line + "\n";
+}
+
+ResultStore::ResultStore(const std::string &path) : _context(get_run_context()) {
+	_fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+}
+
+ResultStore::~ResultStore() {
+	if (_fd >= 0) {
+		close(_fd);
+	}
+}
+
+bool ResultStore::append(const result_record_t &record) {
+	if (_fd < 0) {
+		return false;
+	}
+	result_record_t full = _context;
+	for (const auto &f : record) {
+		full[f.first] = f.second;
+	}
+	const std::string line = format_result_record(full);
+	std::lock_guard<std::mutex> lock(_mtx);
+	return write(_fd, line.data(), line.size()) == static_cast<ssize_t>(line.size());
+}
+
+bool load_result_records(const std::string &path, std::vector<result_record_t> &records) {
+	std::ifstream in(path);
+	if (!in) {
+		return false;
+	}
+	std::string line;
+	while (std::getline(in, line)) {
+		result_record_t r;
+		std::stringstream fields(line);
+		std::string field;
+		while (std::getline(fields, field, '\t')) {
+			const size_t eq = field.find('=');
+			if (eq != std::string::npos) {
+				r[unescape_field(field.substr(0, eq))] = unescape_field(field.substr(eq + 1));
+			}
+		}
+		// a sweep killed while writing leaves a truncated last line
+		if (!r.empty() && r.count("status")) {
+			records.push_back(r);
+		}
+	}
+	return true;
+}
+
+void print_result_records(std::ostream &out, const std::vector<result_record_t> &records) {
+	for (const auto &rec : records) {
+		result_record_t r = rec;
+		out << r["started"] << " " << r["revision"] << " [" << r["compiler"] << "] "
+		    << r["category"] << " " << r["kernel"] << " - " << r["size"] << " - "
+		    << r["type"] << " " << r["memory"];
+		if (!r["layout"].empty()) {
+			out << " " << r["layout"];
+		}
+		if (r["status"] == "ok") {
+			out << " median " << r["median"] << " trials " << r["trials"] << std::endl;
+		} else {
+			out << " " << r["status"] << std::endl;
+		}
+	}
+}
@@ -0,0 +1,56 @@
+#ifndef _STORE_HPP_
+#define _STORE_HPP_
+
+#include "runner.hpp"
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// One line of a result store: field name -> value. Lines are tab separated
+// "name=value" pairs, so that stores can be appended to by concurrent
+// sweeps, grepped and read back without any server.
+typedef std::map<std::string, std::string> result_record_t;
+
+// revision of the harness, hostname, cpu model, kernel release and start
+// time of the sweep
+result_record_t get_run_context();
+
+// first line of "command --version"
+std::string get_compiler_version(const std::string &command);
+
+// fields of a job and of its outcome
+result_record_t make_result_record(const run_element_t &job, const run_result_t &res);
+
+// record as a line of the store, newline included
+std::string format_result_record(const result_record_t &record);
+
+// Appends records to a store file. Every record is written with a single
+// write(2) on an O_APPEND descriptor, so records never interleave.
+class ResultStore {
+ public:
+	explicit ResultStore(const std::string &path);
+	~ResultStore();
+	ResultStore(const ResultStore &) = delete;
+	ResultStore &operator=(const ResultStore &) = delete;
+
+	bool is_open() const { return _fd >= 0; }
+	// adds the run context to record and writes it
+	bool append(const result_record_t &record);
+
+ private:
+	int _fd;
+	result_record_t _context;
+	std::mutex _mtx;
+};
+
+// reads back every record of a store, false when it cannot be opened
+bool load_result_records(const std::string &path, std::vector<result_record_t> &records);
+
+// one line per record: start of its sweep, revision, compiler, version and
+// median time
+void print_result_records(std::ostream &out, const std::vector<result_record_t> &records);
+
+#endif /* end of include guard: _STORE_HPP_ */
@@ -0,0 +1,230 @@
+#include "sweep.hpp"
+
+#include <algorithm>
+#include <ctype.h>
+#include <sstream>
+
+// file name of the remarks of a version, from its label
+static std::string get_remarks_file(const std::string &dir, const std::string &label) {
+	std::string name = label;
+	std::replace_if(name.begin(), name.end(),
+	                [](char c) { return !isalnum(static_cast<unsigned char>(c)) && c != '-'; },
+	                '_');
+	return dir + "/" + name + ".txt";
+}
+
+JobGenerator::JobGenerator(const sweep_space_t &space,
+                           const harness_options_t &opts,
+                           const Checkpoint *checkpoint)
+    : _space(space), _opts(opts), _checkpoint(checkpoint), _started(false),
+      _finished(false), _resumed(0), _pages(0), _layout(0) {}
+
+bool JobGenerator::advance() {
+	if (_finished) {
+		return false;
+	}
+	if (_started) {
+		// innermost dimensions first
+		if (++_layout < _space.layouts.size()) {
+			return true;
+		}
+		_layout = 0;
+		if (++_pages < _space.page_variants.size()) {
+			return true;
+		}
+		_pages = 0;
+		++_type;
+	} else {
+		_started = true;
+		_size = _space.sizes.begin();
+		_category = _space.categories.begin();
+		if (_size == _space.sizes.end() || _category == _space.categories.end() ||
+		    _space.page_variants.empty() || _space.layouts.empty()) {
+			_finished = true;
+			return false;
+		}
+		_kernel = _category->kernel_config_list.begin();
+		if (_kernel != _category->kernel_config_list.end()) {
+			_type = _kernel->data_type_option_list.begin();
+		}
+	}
+	// carry over to the outer dimensions, skipping the empty ones
+	while (true) {
+		if (_kernel != _category->kernel_config_list.end()) {
+			if (_type != _kernel->data_type_option_list.end()) {
+				return true;
+			}
+			if (++_kernel != _category->kernel_config_list.end()) {
+				_type = _kernel->data_type_option_list.begin();
+			}
+			continue;
+		}
+		if (++_category == _space.categories.end()) {
+			if (++_size == _space.sizes.end()) {
+				_finished = true;
+				return false;
+			}
+			_category = _space.categories.begin();
+		}
+		_kernel = _category->kernel_config_list.begin();
+		if (_kernel != _category->kernel_config_list.end()) {
+			_type = _kernel->data_type_option_list.begin();
+		}
+	}
+}
+
+void JobGenerator::describe(run_element_t &job, vc::opt_list_t &options) const {
+	const std::string &pages = _space.page_variants[_pages];
+	const layout_variant_t &layout = _space.layouts[_layout];
+	job = run_element_t();
+	job.category = _category->category_label;
+	job.kernel = _kernel->kernel_label;
+	job.size = _size->first;
+	job.data_type = _type->first;
+	job.memory = describe_memory_options(_opts, pages);
+	job.pages = pages;
+	job.layout = layout.label;
+	job.label = job.category + " " + job.kernel + " - " + job.size + " - " + job.data_type;
+	if (_space.page_variants.size() > 1) {
+		job.label += " - pages " + pages;
+	}
+	if (!layout.label.empty()) {
+		job.label += " - " + layout.label;
+	}
+	job.source_file = _space.source_dir + "/" + _category->category_folder + "/" +
+	                  _kernel->kernel_folder + "/" + _kernel->fileName;
+	job.parallel = _kernel->parallel;
+	job.work_exponent = _kernel->work_exponent;
+	if (!_kernel->reference_file.empty()) {
+		for (const auto &k : _category->kernel_config_list) {
+			if (k.kernel_folder == _kernel->kernel_folder &&
+			    k.fileName == _kernel->reference_file) {
+				job.reference_kernel = k.kernel_label;
+			}
+		}
+	}
+	options = {
+		_size->second,
+		_type->second,
+	};
+	options.insert(options.end(), _space.default_options.begin(), _space.default_options.end());
+	options.insert(options.end(), _kernel->extra_options.begin(), _kernel->extra_options.end());
+	for (const auto &flag : get_memory_flags(_opts, pages)) {
+		options.push_back(vc::make_option(flag));
+	}
+	for (const auto &flag : layout.flags) {
+		options.push_back(vc::make_option(flag));
+	}
+	for (const auto &flag : _opts.extra_flags) {
+		options.push_back(vc::make_option(flag));
+	}
+	job.compiler = _space.compiler_version;
+	for (const auto &o : options) {
+		job.options += (job.options.empty() ? "" : " ") + o.getPrefix() + o.getValue();
+	}
+	// not part of the options: the path changes, the version does not
+	if (!_space.remarks_dir.empty()) {
+		job.remarks_file = get_remarks_file(_space.remarks_dir, job.label);
+		options.push_back(get_remarks_option(job.remarks_file, _space.clang));
+	}
+}
+
+bool JobGenerator::next(run_element_t &job) {
+	std::lock_guard<std::mutex> lock(_mtx);
+	vc::opt_list_t options;
+	while (advance()) {
+		if (!is_selected(_opts, _category->category_label, _kernel->kernel_label,
+		                 _size->first, _type->first)) {
+			continue;
+		}
+		describe(job, options);
+		if (_checkpoint && _checkpoint->done(job)) {
+			_resumed++;
+			continue;
+		}
+		const std::string kernelSourceDir = _space.source_dir + "/" +
+		                                    _category->category_folder + "/" +
+		                                    _kernel->kernel_folder;
+		vc::Version::Builder builder;
+		builder._compiler = _space.compiler;
+		builder.addIncludeDir(kernelSourceDir);
+		builder.options(options);
+		builder.addSourceFile(job.source_file);
+		builder.addSourceFile(_space.source_dir + "/utilities/polybench.c");
+		builder._functionName = get_runner_symbols(_kernel->function_name);
+		job.version = builder.build();
+		if (_opts.validate && !_kernel->reference_file.empty()) {
+			// same build, but for the source and the remarks
+			vc::opt_list_t ref_options;
+			for (const auto &o : options) {
+				if (o.getTag() != REMARKS_OPTION_TAG) {
+					ref_options.push_back(o);
+				}
+			}
+			vc::Version::Builder ref_builder;
+			ref_builder._compiler = _space.compiler;
+			ref_builder.addIncludeDir(kernelSourceDir);
+			ref_builder.options(ref_options);
+			ref_builder.addSourceFile(kernelSourceDir + "/" + _kernel->reference_file);
+			ref_builder.addSourceFile(_space.source_dir + "/utilities/polybench.c");
+			ref_builder._functionName = get_runner_symbols(_kernel->function_name);
+			job.reference = ref_builder.build();
+		}
+		return true;
+	}
+	return false;
+}
+
+size_t JobGenerator::resumed() const {
+	std::lock_guard<std::mutex> lock(_mtx);
+	return _resumed;
+}
+
+run_element_t make_variant(const run_element_t &job, const std::string &flags) {
+	run_element_t variant = job;
+	variant.reference.reset();
+	vc::Version::Builder builder(job.version);
+	variant.label += " - " + flags;
+	// every variant writes its own remarks
+	if (!job.remarks_file.empty()) {
+		variant.remarks_file = get_remarks_file(
+		                       job.remarks_file.substr(0, job.remarks_file.rfind('/')),
+		                       variant.label);
+		for (auto &o : builder._optionList) {
+			if (o.getTag() == REMARKS_OPTION_TAG) {
+				o = vc::Option(REMARKS_OPTION_TAG, o.getPrefix(), variant.remarks_file);
+			}
+		}
+	}
+	std::stringstream ss(flags);
+	std::string flag;
+	while (ss >> flag) {
+		builder.addOption(vc::make_option(flag));
+		variant.options += " " + flag;
+	}
+	variant.version = builder.build();
+	return variant;
+}
+
+VersionCache::~VersionCache() {
+	for (const auto &v : _loaded) {
+		v->fold();
+	}
+}
+
+void VersionCache::retire(const run_element_t &job) {
+	if (!job.version) {
+		return;
+	}
+	std::shared_ptr<vc::Version> evicted;
+	{
+		std::lock_guard<std::mutex> lock(_mtx);
+		_loaded.push_back(job.version);
+		if (_loaded.size() <= _max_loaded) {
+			return;
+		}
+		evicted = _loaded.front();
+		_loaded.pop_front();
+	}
+	evicted->fold();
+}
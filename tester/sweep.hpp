@@ -0,0 +1,120 @@
+#ifndef _SWEEP_HPP_
+#define _SWEEP_HPP_
+
+#include "versioningCompiler/Version.hpp"
+#include "checkpoint.hpp"
+#include "options.hpp"
+#include "padding.hpp"
+#include "runner.hpp"
+
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef std::pair<std::string, vc::Option> list_element_t;
+
+typedef struct kd_t{
+	std::string kernel_label;
+	std::string kernel_folder;
+	std::string fileName;
+	std::string function_name;
+	std::list<list_element_t> data_type_option_list;
+	vc::opt_list_t extra_options;  // flags the kernel is meant for, after the defaults
+	std::string reference_file;    // kernel it must agree with (empty: none)
+	bool parallel = false;         // OpenMP variant, studied by --scaling
+	int work_exponent = 0;         // work grows as its dimensions to this power
+	                               // (0: unknown, no weak scaling)
+} kernel_descriptor_t;
+
+typedef struct cat_t {
+	std::string category_label;
+	std::string category_folder;
+	std::list<kernel_descriptor_t> kernel_config_list;
+} category_t;
+
+// experiment space: every combination of these is a version
+typedef struct ss_t {
+	std::list<list_element_t> sizes;
+	std::list<category_t> categories;
+	std::vector<std::string> page_variants;
+	std::vector<layout_variant_t> layouts;
+	vc::opt_list_t default_options;
+	std::shared_ptr<vc::Compiler> compiler;
+	std::string compiler_version;
+	std::string source_dir;         // root of the PolyBench sources
+	bool clang;                     // the compiler takes clang options
+	std::string remarks_dir;        // where vectorizer remarks go (empty: none)
+} sweep_space_t;
+
+// Enumerates the versions of a sweep space lazily, in the order of the
+// space (size, category, kernel, data type, pages, layout), skipping those
+// rejected by the filters of opts or already in the checkpoint. Versions
+// are only built when handed out, so that memory does not grow with the
+// size of the sweep.
+class JobGenerator {
+ public:
+	JobGenerator(const sweep_space_t &space,
+	             const harness_options_t &opts,
+	             const Checkpoint *checkpoint);
+
+	// builds the next version, false at the end of the sweep. Safe to call
+	// from concurrent workers.
+	bool next(run_element_t &job);
+
+	// versions skipped as already done by the checkpoint
+	size_t resumed() const;
+
+ private:
+	typedef std::list<list_element_t>::const_iterator size_it_t;
+	typedef std::list<category_t>::const_iterator category_it_t;
+	typedef std::list<kernel_descriptor_t>::const_iterator kernel_it_t;
+	typedef std::list<list_element_t>::const_iterator type_it_t;
+
+	// moves to the next point of the space, false past the end
+	bool advance();
+	// metadata and options of the current point
+	void describe(run_element_t &job, vc::opt_list_t &options) const;
+
+	const sweep_space_t &_space;
+	const harness_options_t &_opts;
+	const Checkpoint *_checkpoint;
+	mutable std::mutex _mtx;
+	bool _started;
+	bool _finished;
+	size_t _resumed;
+	size_it_t _size;
+	category_it_t _category;
+	kernel_it_t _kernel;
+	type_it_t _type;
+	size_t _pages;
+	size_t _layout;
+};
+
+// job rebuilt with extra compiler flags (space separated), which override
+// the ones of the job, e.g. -O3 after -O0. The version is not compiled, nor
+// validated.
+run_element_t make_variant(const run_element_t &job, const std::string &flags);
+
+// Retention policy of the versions once they ran: the last max_loaded ones
+// stay compiled and loaded, older ones are folded (their shared object is
+// unloaded and their files removed) and released. With max_loaded 0 every
+// version is folded right after its run.
+class VersionCache {
+ public:
+	explicit VersionCache(size_t max_loaded) : _max_loaded(max_loaded) {}
+	~VersionCache();
+
+	// safe to call from concurrent workers
+	void retire(const run_element_t &job);
+
+ private:
+	size_t _max_loaded;
+	std::mutex _mtx;
+	std::deque<std::shared_ptr<vc::Version> > _loaded;
+};
+
+#endif /* end of include guard: _SWEEP_HPP_ */
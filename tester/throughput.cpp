@@ -0,0 +1,124 @@
+#include "throughput.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+std::vector<cpu_list_t> make_worker_groups(const cpu_list_t &cpus,
+                                           size_t group_size,
+                                           bool interference) {
+	std::vector<cpu_list_t> groups;
+	std::vector<cpu_list_t> slices = get_llc_groups(cpus);
+	if (interference && !slices.empty()) {
+		slices.resize(1);
+		if (group_size == 0) {
+			group_size = 1;
+		}
+	}
+	for (const auto &slice : slices) {
+		const size_t step = group_size ? group_size : slice.size();
+		// leftovers smaller than a group would make workers uneven
+		for (size_t first = 0; first + step <= slice.size(); first += step) {
+			groups.push_back(cpu_list_t(slice.begin() + first,
+			                            slice.begin() + first + step));
+		}
+	}
+	return groups;
+}
+
+size_t run_throughput(JobGenerator &jobs,
+                      const harness_options_t &opts,
+                      const result_handler_t &on_result) {
+	const cpu_list_t cpus = opts.measure_cpus.empty() ? get_thread_affinity()
+	                                                  : opts.measure_cpus;
+	const std::vector<cpu_list_t> groups = make_worker_groups(cpus,
+	                                                          opts.worker_group_size,
+	                                                          opts.interference);
+	if (groups.empty()) {
+		std::cerr << "Error: no worker group of " << opts.worker_group_size
+		          << " cpus fits in " << format_cpu_list(cpus) << std::endl;
+		return 1;
+	}
+
+	std::mutex out_mtx;
+	std::atomic<size_t> done(0), failed(0);
+	double kernel_time = 0;
+	const auto sweep_start = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> workers;
+	for (size_t w = 0; w < groups.size(); w++) {
+		workers.push_back(std::thread([&, w]() {
+			// each worker faults its own arenas in from its own cpus, one
+			// per page size compared
+			std::unique_ptr<Arena> arena, small_page_arena;
+			if (opts.arena_size) {
+				pin_current_thread(groups[w]);
+				arena.reset(new Arena(opts.arena_size, opts.hugepages,
+				                      opts.numa_policy, opts.numa_node));
+				if (opts.compare_hugepages && opts.hugepages != "none") {
+					small_page_arena.reset(new Arena(opts.arena_size, "none",
+					                                 opts.numa_policy, opts.numa_node));
+				}
+				if (!arena->data() || (small_page_arena && !small_page_arena->data())) {
+					std::lock_guard<std::mutex> lock(out_mtx);
+					std::cerr << "Worker " << w << " runs without arena" << std::endl;
+					arena.reset();
+					small_page_arena.reset();
+				}
+			}
+			run_element_t j;
+			while (jobs.next(j)) {
+				{
+					std::lock_guard<std::mutex> lock(out_mtx);
+					std::cout << "worker " << w << " working on " << j.label << std::endl;
+				}
+				run_config_t cfg;
+				cfg.compile_cpus = opts.housekeeping_cpus;
+				cfg.run_cpus = groups[w];
+				cfg.arena = arena.get();
+				cfg.small_page_arena = small_page_arena.get();
+				cfg.trials = opts.trials;
+				cfg.exclusive = false;
+				cfg.tolerance = opts.tolerance;
+				const run_result_t r = run_job(j, cfg);
+				if (on_result) {
+					on_result(j, r);
+				}
+				done++;
+				std::lock_guard<std::mutex> lock(out_mtx);
+				if (!r.ok) {
+					failed++;
+					continue;
+				}
+				kernel_time += r.elapsed;
+				std::cout << "result " << j.label << " " << r.elapsed
+				          << " worker " << w << " "
+				          << describe_placement(r.placement) << " "
+				          << j.memory << " " << describe_alloc_stats(r.alloc) << " "
+				          << describe_resource_usage(r.usage) << std::endl;
+				if (!j.remarks_file.empty()) {
+					std::cout << "vectorization " << j.label << ": "
+					          << describe_remarks(r.remarks) << std::endl;
+				}
+				if (r.validation.checked) {
+					std::cout << "validation " << j.label << ": "
+					          << describe_validation(r.validation) << std::endl;
+				}
+			}
+		}));
+	}
+	for (auto &t : workers) {
+		t.join();
+	}
+
+	const double sweep_time = std::chrono::duration<double>(
+	                          std::chrono::steady_clock::now() - sweep_start).count();
+	std::cout << "throughput: " << done << " jobs (" << failed << " failed) on "
+	          << groups.size() << " workers" << (opts.interference ? " (interference)" : "")
+	          << ", sweep " << sweep_time << " s, kernel time " << kernel_time << " s"
+	          << std::endl;
+	return failed;
+}
@@ -0,0 +1,26 @@
+#ifndef _THROUGHPUT_HPP_
+#define _THROUGHPUT_HPP_
+
+#include "options.hpp"
+#include "runner.hpp"
+#include "sweep.hpp"
+
+#include <vector>
+
+// Split cpus into disjoint worker groups. Each group lies within one last
+// level cache slice and has group_size cpus (0: the whole slice). With
+// interference every group is carved out of the same slice, so that
+// workers share cache and memory bandwidth on purpose.
+std::vector<cpu_list_t> make_worker_groups(const cpu_list_t &cpus,
+                                           size_t group_size,
+                                           bool interference);
+
+// Runs jobs concurrently, one worker per group. Idle workers pull the next
+// version from the generator, so that long jobs do not leave the rest of
+// the machine idle. Every result is passed to on_result, when given, which
+// is then in charge of the version. Returns the number of jobs which failed.
+size_t run_throughput(JobGenerator &jobs,
+                      const harness_options_t &opts,
+                      const result_handler_t &on_result = nullptr);
+
+#endif /* end of include guard: _THROUGHPUT_HPP_ */
@@ -0,0 +1,90 @@
+#include "validate.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+bool capture_dump(int (*run)(int argc, char *argv[]),
+                  void (*set_dump_target)(FILE *target),
+                  std::vector<double> &values) {
+	values.clear();
+	if (!set_dump_target) {
+		return false;
+	}
+	FILE *target = tmpfile();
+	if (!target) {
+		return false;
+	}
+	char empty[] = "";
+	std::vector<char*> argv(44, nullptr);
+	argv[0] = empty;
+	set_dump_target(target);
+	run(43, argv.data());
+	set_dump_target(nullptr);
+	rewind(target);
+
+	std::string text;
+	char buf[4096];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), target)) > 0) {
+		text.append(buf, n);
+	}
+	fclose(target);
+
+	std::istringstream dump(text);
+	std::string line;
+	bool in_dump = false;
+	while (std::getline(dump, line)) {
+		std::istringstream ss(line);
+		std::string token;
+		if (line.compare(0, 11, "begin dump:") == 0) {
+			// the first values may follow the array name
+			ss >> token >> token >> token;
+			in_dump = true;
+		} else if (line.compare(0, 10, "end   dump") == 0 || line.compare(0, 2, "==") == 0) {
+			in_dump = false;
+			continue;
+		}
+		if (!in_dump) {
+			continue;
+		}
+		while (ss >> token) {
+			char *end = nullptr;
+			const double v = strtod(token.c_str(), &end);
+			if (end != token.c_str() && *end == '\0') {
+				values.push_back(v);
+			}
+		}
+	}
+	return !values.empty();
+}
+
+validation_t compare_dumps(const std::vector<double> &values,
+                           const std::vector<double> &reference,
+                           double tolerance) {
+	validation_t v;
+	v.checked = true;
+	v.values = reference.size();
+	v.max_error = 0;
+	for (size_t i = 0; i < std::min(values.size(), reference.size()); i++) {
+		const double err = std::fabs(values[i] - reference[i]) /
+		                   std::max(std::fabs(reference[i]), 1.0);
+		// NaN must not pass
+		v.max_error = std::isnan(err) ? err : std::max(v.max_error, err);
+	}
+	v.passed = values.size() == reference.size() && v.max_error <= tolerance;
+	return v;
+}
+
+std::string describe_validation(const validation_t &v) {
+	if (!v.checked) {
+		return "not checked";
+	}
+	std::ostringstream out;
+	out << (v.passed ? "passed" : "FAILED") << " values=" << v.values
+	    << " max_error=" << v.max_error;
+	return out.str();
+}
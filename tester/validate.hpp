@@ -0,0 +1,34 @@
+#ifndef _VALIDATE_HPP_
+#define _VALIDATE_HPP_
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+// outcome of the comparison of a version with its reference implementation
+typedef struct va_t {
+	bool checked;      // a reference was run
+	bool passed;       // same number of values, all within the tolerance
+	size_t values;     // live-out values of the reference
+	double max_error;  // largest |value - reference| / max(|reference|, 1)
+} validation_t;
+
+// runs a PolyBench entry point with the arguments enabling print_array
+// (argc > 42, empty argv[0]) and parses the live-out values it dumps. The
+// dump goes to a stream of its own through set_dump_target, so that
+// whatever else the process writes to stderr meanwhile is left out.
+bool capture_dump(int (*run)(int argc, char *argv[]),
+                  void (*set_dump_target)(FILE *target),
+                  std::vector<double> &values);
+
+// the dumps print float types with two decimals, hence an absolute error
+// below 1 and a relative one above
+validation_t compare_dumps(const std::vector<double> &values,
+                           const std::vector<double> &reference,
+                           double tolerance);
+
+std::string describe_validation(const validation_t &v);
+
+#endif /* end of include guard: _VALIDATE_HPP_ */
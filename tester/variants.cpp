@@ -0,0 +1,47 @@
+#include "variants.hpp"
+
+// what must match between a variant and its reference run
+static std::string get_setup(const run_element_t &job) {
+	std::string setup = job.size + " - " + job.data_type + " - " + job.memory;
+	if (!job.layout.empty()) {
+		setup += " - " + job.layout;
+	}
+	return setup;
+}
+
+void VariantReport::add(const run_element_t &job, const run_result_t &res) {
+	if (!res.ok) {
+		return;
+	}
+	const std::string setup = get_setup(job);
+	std::lock_guard<std::mutex> lock(_mtx);
+	_times[job.category + " " + job.kernel + " - " + setup] = res.elapsed;
+	if (job.reference_kernel.empty()) {
+		return;
+	}
+	const std::string variant = job.category + " " + job.kernel;
+	if (_variants.find(variant) == _variants.end()) {
+		_order.push_back(variant);
+	}
+	_variants[variant].push_back({setup, job.category + " " + job.reference_kernel +
+	                                     " - " + setup, res.elapsed});
+}
+
+void VariantReport::print(std::ostream &out) const {
+	std::lock_guard<std::mutex> lock(_mtx);
+	for (const auto &variant : _order) {
+		for (const auto &e : _variants.at(variant)) {
+			out << "variant " << variant << " - " << e.setup << ": " << e.elapsed;
+			const auto ref = _times.find(e.reference);
+			if (ref == _times.end()) {
+				out << " (reference not run)" << std::endl;
+				continue;
+			}
+			out << " (reference " << ref->second;
+			if (e.elapsed > 0) {
+				out << ", throughput x" << ref->second / e.elapsed;
+			}
+			out << ")" << std::endl;
+		}
+	}
+}
@@ -0,0 +1,34 @@
+#ifndef _VARIANTS_HPP_
+#define _VARIANTS_HPP_
+
+#include "runner.hpp"
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Collects the times of the optimized variants (versions with a
+// reference_kernel) and of their reference kernels, and reports the
+// throughput of every variant relative to its reference, kernel by kernel
+// across the sizes of the sweep.
+class VariantReport {
+ public:
+	void add(const run_element_t &job, const run_result_t &res);
+	void print(std::ostream &out) const;
+
+ private:
+	typedef struct ve_t {
+		std::string setup;      // size, data type, memory and layout
+		std::string reference;  // key of the reference run in _times
+		double elapsed;
+	} entry_t;
+
+	mutable std::mutex _mtx;
+	std::map<std::string, double> _times;  // every successful run
+	std::vector<std::string> _order;       // variants, in order of arrival
+	std::map<std::string, std::vector<entry_t> > _variants;
+};
+
+#endif /* end of include guard: _VARIANTS_HPP_ */